@@ -0,0 +1,106 @@
+/**
+ * @file SharedPointerBenchmark.cpp
+ * @brief Microbenchmark de TSharedPointer contra std::shared_ptr.
+ *
+ * Mide el rendimiento de copia, movimiento y destruccin de:
+ *  - TSharedPointer con ThreadSafePolicy (contador atmico).
+ *  - TSharedPointer con SingleThreadPolicy (contador simple).
+ *  - std::shared_ptr.
+ *
+ * Es un ejecutable independiente del motor; no forma parte de GalvanEngine.vcxproj
+ * porque define su propio main(). Compilar en Release desde esta carpeta con:
+ *
+ *     cl /std:c++17 /O2 /EHsc /I ..\include SharedPointerBenchmark.cpp
+ */
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "Memory\TSharedPointer.h"
+
+namespace {
+	/// Nmero de punteros que se copian, mueven y destruyen por prueba.
+	constexpr int kIterations = 1000000;
+
+	/**
+	 * @brief Resultado de una prueba en nanosegundos por operacin.
+	 */
+	struct BenchmarkResult {
+		double copyNs;    ///< Tiempo por copia.
+		double moveNs;    ///< Tiempo por movimiento.
+		double destroyNs; ///< Tiempo por destruccin (ltima referencia).
+	};
+
+	/**
+	 * @brief Devuelve los nanosegundos transcurridos desde start.
+	 */
+	double elapsedNs(std::chrono::steady_clock::time_point start) {
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+
+	/**
+	 * @brief Ejecuta las tres pruebas para un tipo de puntero compartido.
+	 * @tparam Pointer Tipo de puntero compartido a medir.
+	 * @param make Funcin que crea un puntero nuevo.
+	 */
+	template<typename Pointer, typename MakeFn>
+	BenchmarkResult runBenchmark(MakeFn make) {
+		BenchmarkResult result{};
+		Pointer source = make();
+
+		// Copia: cada copia incrementa el contador compartido.
+		std::vector<Pointer> copies;
+		copies.reserve(kIterations);
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < kIterations; ++i) {
+			copies.push_back(source);
+		}
+		result.copyNs = elapsedNs(start) / kIterations;
+
+		// Movimiento: transfiere la propiedad sin tocar el contador.
+		std::vector<Pointer> moved;
+		moved.reserve(kIterations);
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < kIterations; ++i) {
+			moved.push_back(std::move(copies[i]));
+		}
+		result.moveNs = elapsedNs(start) / kIterations;
+		moved.clear();
+		copies.clear();
+
+		// Destruccin: cada puntero es dueo nico, se libera objeto y contador.
+		std::vector<Pointer> owners;
+		owners.reserve(kIterations);
+		for (int i = 0; i < kIterations; ++i) {
+			owners.push_back(make());
+		}
+		start = std::chrono::steady_clock::now();
+		owners.clear();
+		result.destroyNs = elapsedNs(start) / kIterations;
+
+		return result;
+	}
+
+	/**
+	 * @brief Imprime una fila de la tabla de resultados.
+	 */
+	void printResult(const char* name, const BenchmarkResult& result) {
+		std::printf("%-34s %10.2f %10.2f %10.2f\n", name, result.copyNs, result.moveNs, result.destroyNs);
+	}
+}
+
+int main() {
+	using namespace EngineUtilities;
+
+	std::printf("%-34s %10s %10s %10s\n", "ns/op", "copy", "move", "destroy");
+
+	printResult("TSharedPointer<ThreadSafePolicy>",
+		runBenchmark<TSharedPointer<int, ThreadSafePolicy>>([] { return MakeShared<int>(1); }));
+	printResult("TSharedPointer<SingleThreadPolicy>",
+		runBenchmark<TLocalSharedPointer<int>>([] { return MakeLocalShared<int>(1); }));
+	printResult("std::shared_ptr",
+		runBenchmark<std::shared_ptr<int>>([] { return std::make_shared<int>(1); }));
+
+	return 0;
+}
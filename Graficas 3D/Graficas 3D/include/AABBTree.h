@@ -0,0 +1,166 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @class AABBTree
+ * @brief rbol dinmico de cajas alineadas a los ejes (AABB) para consultas espaciales.
+ *
+ * Cada objeto registrado es un *proxy*: una hoja del rbol con una caja "gorda", que
+ * es su caja real agrandada por un margen. Mover un objeto solo reinserta su hoja cuando
+ * la caja real se sale de la gorda, as que los movimientos pequeos no tocan el rbol.
+ *
+ * Los nodos internos guardan la unin de las cajas de sus hijos. La insercin elige el
+ * hermano que menos aumenta el permetro total, y el rbol se equilibra con rotaciones
+ * al subir, como el rbol dinmico de Box2D.
+ *
+ * Los nodos viven en un arreglo contiguo con lista de libres; los identificadores de
+ * proxy son ndices en ese arreglo y no cambian mientras el proxy exista.
+ *
+ * No es seguro para hilos: crear, mover o destruir proxies de un mismo rbol desde
+ * varios hilos a la vez es una condicin de carrera.
+ */
+class AABBTree {
+public:
+	/// Identificador invlido de proxy o nodo.
+	static constexpr int NullNode = -1;
+
+	/**
+	 * @brief Constructor.
+	 * @param margin Cunto se agranda la caja de cada proxy por lado.
+	 */
+	explicit AABBTree(float margin = 8.0f);
+
+	/**
+	 * @brief Registra un objeto.
+	 * @param bounds Caja del objeto.
+	 * @param userData Dato asociado que devuelven las consultas.
+	 * @return Identificador del proxy.
+	 */
+	int createProxy(const sf::FloatRect& bounds, void* userData);
+
+	/**
+	 * @brief Elimina un objeto.
+	 * @param proxyId Identificador del proxy.
+	 */
+	void destroyProxy(int proxyId);
+
+	/**
+	 * @brief Actualiza la caja de un objeto.
+	 * @param proxyId Identificador del proxy.
+	 * @param bounds Nueva caja del objeto.
+	 * @return true si la hoja se reinsert; false si la caja gorda todava la contena.
+	 */
+	bool moveProxy(int proxyId, const sf::FloatRect& bounds);
+
+	/**
+	 * @brief Obtiene el dato asociado a un proxy.
+	 */
+	void* getUserData(int proxyId) const { return m_nodes[proxyId].userData; }
+
+	/**
+	 * @brief Obtiene la caja gorda de un proxy.
+	 */
+	sf::FloatRect getFatBounds(int proxyId) const;
+
+	/**
+	 * @brief Recorre los proxies cuya caja gorda toca un rectngulo.
+	 * @param rect Rectngulo de consulta.
+	 * @param function Funcin `bool(int proxyId)`; si devuelve false, la consulta termina.
+	 *
+	 * Como se usan las cajas gordas, puede devolver objetos que estn hasta `margin`
+	 * afuera del rectngulo.
+	 */
+	template<typename Function>
+	void query(const sf::FloatRect& rect, Function&& function) const {
+		if (m_root == NullNode) {
+			return;
+		}
+		const Box box = toBox(rect);
+
+		std::vector<int> stack;
+		stack.reserve(64);
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			const int nodeId = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_nodes[nodeId];
+			if (!overlaps(node.box, box)) {
+				continue;
+			}
+			if (node.isLeaf()) {
+				if (!function(nodeId)) {
+					return;
+				}
+			}
+			else {
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	/**
+	 * @brief Elimina todos los proxies.
+	 */
+	void clear();
+
+	/**
+	 * @brief Nmero de proxies registrados.
+	 */
+	std::size_t proxyCount() const { return m_proxyCount; }
+
+	/**
+	 * @brief Altura del rbol (0 si est vaco o tiene una sola hoja).
+	 */
+	int getHeight() const { return m_root == NullNode ? 0 : m_nodes[m_root].height; }
+
+private:
+	/**
+	 * @brief Caja guardada como mnimo y mximo.
+	 */
+	struct Box {
+		sf::Vector2f min;
+		sf::Vector2f max;
+	};
+
+	/**
+	 * @brief Nodo del rbol: hoja (proxy) o nodo interno con dos hijos.
+	 */
+	struct Node {
+		Box box;                  ///< Caja gorda (hoja) o unin de los hijos.
+		void* userData = nullptr; ///< Dato del proxy; solo en hojas.
+		int parent = NullNode;    ///< Padre, o siguiente libre si el nodo no est en uso.
+		int child1 = NullNode;    ///< Primer hijo; NullNode en hojas.
+		int child2 = NullNode;    ///< Segundo hijo; NullNode en hojas.
+		int height = -1;          ///< 0 en hojas, -1 si el nodo est libre.
+
+		bool isLeaf() const { return child1 == NullNode; }
+	};
+
+	static Box toBox(const sf::FloatRect& rect);
+	static Box combine(const Box& a, const Box& b);
+	static float perimeter(const Box& box);
+	static bool contains(const Box& outer, const Box& inner);
+	static bool overlaps(const Box& a, const Box& b) {
+		return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+			a.min.y <= b.max.y && b.min.y <= a.max.y;
+	}
+
+	int allocateNode();
+	void freeNode(int nodeId);
+	void insertLeaf(int leaf);
+	void removeLeaf(int leaf);
+
+	/**
+	 * @brief Equilibra el subrbol de un nodo con una rotacin si hace falta.
+	 * @return El nodo que qued como raz del subrbol.
+	 */
+	int balance(int nodeId);
+
+	std::vector<Node> m_nodes;      ///< Nodos, en uso y libres.
+	int m_root = NullNode;          ///< Raz del rbol.
+	int m_freeList = NullNode;      ///< Primer nodo libre.
+	std::size_t m_proxyCount = 0;   ///< Hojas en uso.
+	float m_margin;                 ///< Margen de las cajas gordas.
+};
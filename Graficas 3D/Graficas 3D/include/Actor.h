@@ -65,40 +65,6 @@ public:
      */
     void destroy();
 
-    /**
-     * @brief Obtiene un componente especfico del actor.
-     * @tparam T Tipo del componente que se va a obtener.
-     * @return Puntero compartido al componente, o nullptr si no se encuentra.
-     *
-     * Este mtodo busca entre los componentes del actor uno que coincida
-     * con el tipo proporcionado. Si lo encuentra, lo devuelve como un puntero
-     * compartido. Si no lo encuentra, devuelve nullptr.
-     */
-    template <typename T>
-    EngineUtilities::TSharedPointer<T> getComponent();
-
 private:
     std::string m_name = "Actor"; ///< Nombre del actor.
 };
-
-/**
- * @brief Implementacin de getComponent.
- *
- * Busca entre los componentes del actor uno que coincida con el tipo
- * especificado en la plantilla. Utiliza dynamic_pointer_cast para intentar
- * convertir el componente al tipo solicitado.
- *
- * @tparam T Tipo del componente que se va a obtener.
- * @return Un puntero compartido al componente, o un puntero vaco si no se encuentra.
- */
-template<typename T>
-inline EngineUtilities::TSharedPointer<T> Actor::getComponent() {
-    for (auto& component : components) {
-        EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-        if (specificComponent) {
-            return specificComponent;
-        }
-    }
-    // Devuelve un TSharedPointer vaco si no se encuentra el componente
-    return EngineUtilities::TSharedPointer<T>();
-}
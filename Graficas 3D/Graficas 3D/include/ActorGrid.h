@@ -0,0 +1,86 @@
+#pragma once
+#include "Prerequisites.h"
+#include "UniformGrid.h"
+#include "EntityRegistry.h"
+
+/**
+ * @class ActorGrid
+ * @brief Consultas espaciales sobre los actores de un registro.
+ *
+ * En cada `rebuild` toma la posicin del `ShapeFactory` de los actores activos y arma
+ * con ellas una `UniformGrid`. Con esa estructura responde qu actores estn dentro
+ * de un radio (percepcin de la IA), cules son los k ms cercanos a un punto, qu
+ * actor hay bajo un punto (seleccin con el mouse) y qu pares de actores estn cerca
+ * (fase amplia de colisiones).
+ *
+ * Los resultados son punteros a los actores del ltimo `rebuild`; valen hasta el
+ * siguiente `EntityRegistry::flushDestroyed`. Las posiciones tambin son las del
+ * ltimo `rebuild`, as que conviene reconstruir una vez por fotograma antes de
+ * consultar.
+ */
+class ActorGrid {
+public:
+	/**
+	 * @brief Constructor.
+	 * @param cellSize Lado de las celdas; conviene que sea parecido al radio tpico de las consultas.
+	 */
+	explicit ActorGrid(float cellSize = 64.0f) : m_grid(cellSize) {}
+
+	/**
+	 * @brief Reconstruye la rejilla con los actores activos que tienen forma.
+	 * @param actors Registro de actores.
+	 */
+	void rebuild(EntityRegistry& actors);
+
+	/**
+	 * @brief Busca los actores a distancia `radius` o menos de un punto.
+	 * @param center Centro de la bsqueda.
+	 * @param radius Radio de la bsqueda; se mide a la posicin de cada actor.
+	 * @param out Vector donde se dejan, ordenados por id; se vaca antes.
+	 */
+	void queryRange(const sf::Vector2f& center, float radius, std::vector<Actor*>& out) const;
+
+	/**
+	 * @brief Busca los `k` actores ms cercanos a un punto.
+	 * @param center Centro de la bsqueda.
+	 * @param k Nmero de actores a buscar.
+	 * @param out Vector donde se dejan, del ms cercano al ms lejano; se vaca antes.
+	 */
+	void queryNearest(const sf::Vector2f& center, std::size_t k, std::vector<Actor*>& out) const;
+
+	/**
+	 * @brief Busca el actor cuya forma contiene un punto.
+	 * @param point Punto en coordenadas de mundo.
+	 * @return Handle del que se dibuja encima (el de id mayor), o un handle invlido si no hay ninguno.
+	 *
+	 * Devuelve un handle porque una seleccin suele guardarse entre fotogramas.
+	 */
+	ActorHandle pick(const sf::Vector2f& point) const;
+
+	/**
+	 * @brief Recorre cada par de actores a distancia `radius` o menos, una sola vez por par.
+	 * @param radius Distancia mxima entre posiciones.
+	 * @param function Funcin `(Actor& a, Actor& b)`.
+	 */
+	template<typename Function>
+	void forEachPair(float radius, Function&& function) const {
+		m_grid.forEachPair(radius, [this, &function](std::uint32_t a, std::uint32_t b, float) {
+			function(*m_actors[a], *m_actors[b]);
+		});
+	}
+
+	/**
+	 * @brief Nmero de actores del ltimo `rebuild`.
+	 */
+	std::size_t size() const { return m_actors.size(); }
+
+	const UniformGrid& getGrid() const { return m_grid; }
+
+private:
+	UniformGrid m_grid;                 ///< Rejilla de posiciones.
+	std::vector<Actor*> m_actors;       ///< Actor de cada punto de la rejilla.
+	std::vector<ActorHandle> m_handles; ///< Handle de cada actor, en el mismo orden.
+	std::vector<float> m_positionX;     ///< Posiciones X, en el orden de `m_actors`.
+	std::vector<float> m_positionY;     ///< Posiciones Y, en el orden de `m_actors`.
+	float m_maxExtent = 0.0f;           ///< Mayor distancia de la posicin de un actor a una esquina de su caja.
+};
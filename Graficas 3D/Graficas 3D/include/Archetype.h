@@ -0,0 +1,187 @@
+#pragma once
+#include "Prerequisites.h"
+#include "ComponentTypeID.h"
+
+struct EntityRecord;
+
+/**
+ * @brief Handle de una entidad del World.
+ */
+using EntityHandle = EngineUtilities::THandle<EntityRecord>;
+
+/**
+ * @struct ComponentColumnInfo
+ * @brief Descripcin de un tipo de componente de datos guardado en una columna.
+ *
+ * Los componentes de datos del World son structs simples (no derivan de Component).
+ * Esta estructura guarda lo necesario para moverlos y destruirlos sin conocer su tipo.
+ */
+struct ComponentColumnInfo {
+    std::uint32_t typeID = 0; ///< Identificador de tipo (ComponentTypeID).
+    std::size_t size = 0;     ///< Tamao en bytes de un componente.
+    std::size_t align = 1;    ///< Alineacin requerida.
+
+    /// Construye en `dst` moviendo desde `src` y destruye `src`.
+    void (*moveAndDestroy)(void* dst, void* src) = nullptr;
+
+    /// Llama al destructor del componente.
+    void (*destroy)(void* ptr) = nullptr;
+
+    /**
+     * @brief Crea la descripcin del tipo T.
+     * @tparam T Tipo del componente de datos.
+     * @return Informacin de columna para T.
+     */
+    template<typename T>
+    static ComponentColumnInfo of() {
+        ComponentColumnInfo info;
+        info.typeID = ComponentTypeID<T>();
+        info.size = sizeof(T);
+        info.align = alignof(T);
+        info.moveAndDestroy = [](void* dst, void* src) {
+            T* source = static_cast<T*>(src);
+            new (dst) T(std::move(*source));
+            source->~T();
+        };
+        info.destroy = [](void* ptr) {
+            static_cast<T*>(ptr)->~T();
+        };
+        return info;
+    }
+};
+
+/**
+ * @class Archetype
+ * @brief Almacn de todas las entidades que tienen exactamente el mismo conjunto de componentes.
+ *
+ * Las entidades se guardan en bloques (chunks) de tamao fijo con disposicin de
+ * estructura de arreglos (SoA): dentro de un chunk cada tipo de componente ocupa un arreglo
+ * contiguo, precedido por el arreglo de handles de entidad. Recorrer un tipo de componente
+ * es, por tanto, un recorrido lineal de memoria.
+ *
+ * Las filas se mantienen compactas: al quitar una entidad, la ltima fila del arquetipo
+ * ocupa su lugar.
+ */
+class Archetype {
+public:
+    /// Tamao de cada chunk en bytes.
+    static constexpr std::size_t CHUNK_BYTES = 16 * 1024;
+
+    /// Alineacin de cada chunk (una lnea de cach).
+    static constexpr std::size_t CHUNK_ALIGN = 64;
+
+    /**
+     * @brief Ubicacin de una fila dentro del arquetipo.
+     */
+    struct Row {
+        std::uint32_t chunk = 0; ///< ndice del chunk.
+        std::uint32_t row = 0;   ///< Fila dentro del chunk.
+    };
+
+    /**
+     * @brief Crea un arquetipo para un conjunto de columnas.
+     * @param columns Columnas ordenadas por identificador de tipo.
+     */
+    explicit Archetype(std::vector<ComponentColumnInfo> columns);
+
+    /**
+     * @brief Destruye los componentes que queden y libera los chunks.
+     */
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    /**
+     * @brief Reserva una fila al final del arquetipo.
+     * @param entity Handle de la entidad duea de la fila.
+     * @return Ubicacin de la nueva fila; sus componentes an no estn construidos.
+     */
+    Row allocateRow(EntityHandle entity);
+
+    /**
+     * @brief Quita una fila cuyos componentes ya fueron destruidos o movidos.
+     * @param row Fila a quitar.
+     * @return Handle de la entidad que pas a ocupar la fila, o un handle nulo si no se movi ninguna.
+     */
+    EntityHandle removeRow(Row row);
+
+    /**
+     * @brief Destruye los componentes de una fila y la quita.
+     * @param row Fila a destruir.
+     * @return Igual que removeRow.
+     */
+    EntityHandle destroyRow(Row row);
+
+    /**
+     * @brief Obtiene la direccin de un componente.
+     * @param row Fila.
+     * @param column ndice de la columna.
+     * @return Puntero a la memoria del componente.
+     */
+    void* componentAt(Row row, std::uint32_t column) {
+        return m_chunks[row.chunk].data + m_offsets[column] + row.row * m_columns[column].size;
+    }
+
+    /**
+     * @brief Obtiene el arreglo de un tipo de componente dentro de un chunk.
+     * @tparam T Tipo del componente; el arquetipo debe contenerlo.
+     * @param chunk ndice del chunk.
+     * @return Puntero al primer elemento del arreglo.
+     */
+    template<typename T>
+    T* column(std::uint32_t chunk) {
+        const std::uint32_t index = columnIndex(ComponentTypeID<T>());
+        return reinterpret_cast<T*>(m_chunks[chunk].data + m_offsets[index]);
+    }
+
+    /**
+     * @brief Obtiene el arreglo de handles de entidad de un chunk.
+     * @param chunk ndice del chunk.
+     * @return Puntero al primer handle.
+     */
+    EntityHandle* entities(std::uint32_t chunk) {
+        return reinterpret_cast<EntityHandle*>(m_chunks[chunk].data);
+    }
+
+    /**
+     * @brief Calcula el ndice de columna de un tipo.
+     * @param typeID Identificador del tipo; debe estar en la mscara.
+     * @return ndice de la columna.
+     */
+    std::uint32_t columnIndex(std::uint32_t typeID) const {
+        return countComponentBits(m_mask & ((ComponentMask(1) << typeID) - 1));
+    }
+
+    /**
+     * @brief Indica si el arquetipo contiene todos los tipos de una mscara.
+     * @param required Mscara de tipos requeridos.
+     * @return true si los contiene.
+     */
+    bool matches(ComponentMask required) const {
+        return (m_mask & required) == required;
+    }
+
+    ComponentMask mask() const { return m_mask; }
+    const std::vector<ComponentColumnInfo>& columns() const { return m_columns; }
+    std::uint32_t chunkCount() const { return static_cast<std::uint32_t>(m_chunks.size()); }
+    std::uint32_t chunkSize(std::uint32_t chunk) const { return m_chunks[chunk].count; }
+    std::uint32_t chunkCapacity() const { return m_capacity; }
+    std::size_t size() const { return m_size; }
+
+private:
+    /**
+     * @brief Bloque de memoria con las filas de un chunk.
+     */
+    struct Chunk {
+        unsigned char* data = nullptr; ///< Memoria del chunk.
+        std::uint32_t count = 0;       ///< Filas ocupadas.
+    };
+
+    std::vector<ComponentColumnInfo> m_columns; ///< Columnas ordenadas por tipo.
+    std::vector<std::size_t> m_offsets;         ///< Desplazamiento de cada columna en el chunk.
+    std::vector<Chunk> m_chunks;                ///< Chunks; todos llenos salvo el ltimo.
+    ComponentMask m_mask = 0;                   ///< Tipos que contiene el arquetipo.
+    std::uint32_t m_capacity = 0;               ///< Filas por chunk.
+    std::size_t m_size = 0;                     ///< Filas totales.
+};
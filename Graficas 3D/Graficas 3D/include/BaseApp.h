@@ -3,6 +3,15 @@
 #include "Window.h"
 #include "ShapeFactory.h"
 #include "Actor.h"
+#include "World.h"
+#include "EntityRegistry.h"
+#include "CommandBuffer.h"
+#include "SystemScheduler.h"
+#include "PathFollowSystem.h"
+#include "FlockingSystem.h"
+#include "SeekSystem.h"
+#include "ActorGrid.h"
+#include "PathService.h"
 
 /**
  * @class BaseApp
@@ -21,6 +30,15 @@ public:
      */
     BaseApp() = default;
 
+    /**
+     * @brief Constructor que elige dnde se dibuja y cunto dura la ejecucin.
+     * @param backend Backend de la ventana; con `SOFTWARE` no se necesita GPU ni pantalla.
+     * @param frameLimit Fotogramas a ejecutar antes de cerrar; 0 para no tener lmite.
+     * @param framePath Si no est vaco, al terminar se guarda ah el ltimo fotograma.
+     */
+    BaseApp(WindowBackend backend, int frameLimit = 0, std::string framePath = "")
+        : m_backend(backend), m_frameLimit(frameLimit), m_framePath(std::move(framePath)) {}
+
     /**
      * @brief Destructor por defecto.
      *
@@ -54,6 +72,21 @@ public:
      */
     void update();
 
+    /**
+     * @brief Resalta el actor que est bajo el mouse.
+     * @param mousePosition Posicin del mouse en coordenadas de mundo.
+     *
+     * El actor que deja de estar bajo el mouse recupera su color.
+     */
+    void updateHover(const sf::Vector2f& mousePosition);
+
+    /**
+     * @brief Pide un camino nuevo para los buscadores que llegaron o no tienen uno.
+     *
+     * Cada buscador recorre por turnos las esquinas de la ventana esquivando los muros.
+     */
+    void updateSeekers();
+
     /**
      * @brief Renderiza el contenido de la aplicacin.
      *
@@ -71,41 +104,102 @@ public:
     void cleanup();
 
     /**
-     * @brief Actualiza el movimiento de un actor.
-     * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
-     * @param circle Puntero compartido al actor que representa un crculo.
+     * @brief Obtiene la arena de memoria del fotograma actual.
+     * @return Referencia a la arena que se reinicia al inicio de cada fotograma.
+     *
+     * Los datos temporales de `update` y `render` (listas de culling, claves de
+     * ordenamiento, resultados de steering) deben reservarse aqu, por ejemplo con
+     * `EngineUtilities::TFrameVector`, en lugar de usar el heap.
+     */
+    EngineUtilities::FrameArena& getFrameArena() { return m_frameArena; }
+
+    /**
+     * @brief Obtiene la cola de comandos estructurales del fotograma.
+     * @return Referencia a la cola que se aplica al terminar `update`.
      *
-     * Esta funcin ajusta la posicin del actor circulo en base al tiempo transcurrido
-     * y a la lgica de movimiento, como seguir waypoints.
+     * Los sistemas y trabajos que corren en paralelo deben crear y destruir actores,
+     * y agregar o quitar componentes, a travs de esta cola.
      */
-    void updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Actor> circle);
+    CommandQueue& getCommands() { return m_commands; }
+
+    /**
+     * @brief Obtiene el World con los componentes de datos de la escena.
+     * @return Referencia al World de la aplicacin.
+     */
+    World& getWorld() { return m_world; }
 
 private:
     sf::Clock clock;   ///< Reloj para medir el tiempo transcurrido entre fotogramas.
     sf::Time deltaTime; ///< Tiempo transcurrido desde el ltimo fotograma.
 
+    /**
+     * @brief Arena lineal para datos temporales del fotograma.
+     *
+     * Se reinicia al inicio de cada iteracin del bucle en `run`.
+     */
+    EngineUtilities::FrameArena m_frameArena{ 1024 * 1024 };
+
     Window* m_window;  ///< Puntero a la ventana principal de la aplicacin.
-    EngineUtilities::TSharedPointer<Actor> Triangle; ///< Actor que representa un tringulo.
-    EngineUtilities::TSharedPointer<Actor> Circle;   ///< Actor que representa un crculo.
+    WindowBackend m_backend = RENDER_WINDOW; ///< Backend con que se crea la ventana.
+    int m_frameLimit = 0;     ///< Fotogramas antes de cerrar; 0 = sin lmite.
+    std::string m_framePath;  ///< Dnde guardar el ltimo fotograma, o vaco.
+    int m_frameCount = 0;     ///< Fotogramas ejecutados.
+    double m_rasterMicroseconds = 0.0; ///< Tiempo total de rasterizado por CPU.
+    RasterizerStats m_rasterStats;     ///< Estadsticas del rasterizado del ltimo fotograma.
+
+    /**
+     * @brief Almacenamiento central de los actores de la escena.
+     *
+     * El registro es dueo de los actores; el resto de la aplicacin los referencia
+     * mediante handles, que se copian sin tocar contadores de referencias. Los actores
+     * destruidos durante el fotograma se liberan juntos al final de `run`.
+     */
+    EntityRegistry m_actors;
+    ActorHandle Triangle; ///< Actor que representa un tringulo.
+    ActorHandle Circle;   ///< Actor que representa un crculo.
+    std::vector<ActorHandle> m_patrols; ///< Actores que patrullan el mismo recorrido que el crculo.
+    std::vector<ActorHandle> m_boids; ///< Actores de la bandada.
+    std::vector<ActorHandle> m_walls; ///< Muros que los buscadores esquivan.
+    std::vector<ActorHandle> m_seekers; ///< Actores que piden caminos a `m_paths`.
+    std::vector<std::size_t> m_seekerGoals; ///< Destino actual de cada buscador.
+    std::vector<Actor*> m_visibleActors; ///< Actores que tocan la vista en el ltimo `render`.
+
+    /**
+     * @brief Consultas espaciales sobre los actores.
+     *
+     * Se reconstruye al inicio de cada `update` con las posiciones del fotograma anterior.
+     */
+    ActorGrid m_actorGrid;
+    ActorHandle m_hovered;        ///< Actor bajo el mouse, o un handle invlido.
+    sf::Color m_hoveredColor;     ///< Color original del actor bajo el mouse.
+
+    /**
+     * @brief Caminos sobre la rejilla de navegacin.
+     *
+     * Busca en el JobSystem sin detener el fotograma y entrega los caminos en `update`.
+     */
+    PathService m_paths{ m_actors };
+
+    /**
+     * @brief Entidades de datos de la escena, guardadas por arquetipo.
+     *
+     * Es el almacenamiento pensado para escenas grandes; los actores siguen
+     * usando componentes polimrficos.
+     */
+    World m_world;
 
     /**
-     * @brief ndice del waypoint actual que el actor sigue.
+     * @brief Sistemas que se ejecutan en cada `update`.
      *
-     * Esta variable indica cul es el waypoint actual al que el actor se est
-     * moviendo.
+     * Se agrupan segn los componentes que leen y escriben para ejecutar en
+     * paralelo los que no entran en conflicto.
      */
-    int currentWaypoint = 0;
+    SystemScheduler m_systems;
 
     /**
-     * @brief Waypoints que el actor sigue.
+     * @brief Cambios estructurales grabados durante `update`.
      *
-     * Define un conjunto de posiciones en pantalla por las que el actor debe
-     * moverse.
+     * Se aplican sobre `m_actors` en `run`, entre `update` y `render`.
      */
-    std::vector<sf::Vector2f> waypoints = {
-      {100.0f, 100.0f},
-      {400.0f, 100.0f},
-      {400.0f, 400.0f},
-      {100.0f, 400.0f}
-    };
+    CommandQueue m_commands;
 };
@@ -0,0 +1,170 @@
+#pragma once
+#include "Prerequisites.h"
+#include "EntityRegistry.h"
+#include <functional>
+
+/**
+ * @class CommandBuffer
+ * @brief Lista de cambios estructurales grabados por un hilo para aplicarse ms tarde.
+ *
+ * Crear o destruir actores y agregar o quitar componentes no es seguro mientras otros
+ * hilos recorren la escena. Durante `update` esos cambios se graban aqu, a travs de un
+ * `CommandRecorder`, y el `CommandQueue` los aplica en el punto de sincronizacin del
+ * fotograma. Solo debe usarlo el hilo al que pertenece.
+ */
+class CommandBuffer {
+public:
+    std::size_t size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+
+private:
+    friend class CommandQueue;
+    friend class CommandRecorder;
+
+    /**
+     * @brief Comando grabado.
+     */
+    struct Command {
+        std::uint64_t sortKey = 0;                     ///< Clave de orden de la tarea que lo grab.
+        std::function<void(EntityRegistry&)> apply;    ///< Cambio a aplicar.
+    };
+
+    /**
+     * @brief Agrega un comando.
+     * @param sortKey Clave de orden de la tarea que lo graba.
+     * @param apply Cambio a aplicar.
+     */
+    void record(std::uint64_t sortKey, std::function<void(EntityRegistry&)> apply) {
+        m_commands.push_back(Command{ sortKey, std::move(apply) });
+    }
+
+    std::vector<Command> m_commands; ///< Comandos en orden de grabacin.
+    std::vector<Command> m_applying; ///< Comandos que se estn aplicando; se vaca y se reutiliza.
+};
+
+/**
+ * @class CommandRecorder
+ * @brief Graba comandos en el bfer de un hilo con la clave de orden de una tarea.
+ *
+ * La clave viaja con el grabador y no con el bfer: si la tarea ejecuta otras en lnea
+ * (con `JobSystem::wait` o `parallelFor`) y estas graban en el mismo bfer con su propia
+ * clave, los comandos que la tarea grabe despus siguen llevando la suya. Se obtiene con
+ * `CommandQueue::local` y solo vale dentro de la tarea que lo pidi.
+ */
+class CommandRecorder {
+public:
+    /**
+     * @brief Constructor.
+     * @param buffer Bfer del hilo que graba.
+     * @param sortKey Clave de orden; debe identificar de forma nica a la tarea que graba.
+     */
+    CommandRecorder(CommandBuffer& buffer, std::uint64_t sortKey)
+        : m_buffer(buffer), m_sortKey(sortKey) {}
+
+    /**
+     * @brief Graba la creacin de un actor.
+     * @param name Nombre del actor.
+     * @param init Funcin opcional que se llama con el actor recin creado.
+     */
+    void createEntity(std::string name, std::function<void(Actor&, ActorHandle)> init = nullptr) {
+        m_buffer.record(m_sortKey, [name = std::move(name), init = std::move(init)](EntityRegistry& registry) {
+            ActorHandle handle = registry.createEntity(name);
+            if (init) {
+                init(*registry.get(handle), handle);
+            }
+        });
+    }
+
+    /**
+     * @brief Graba la destruccin de un actor.
+     * @param handle Handle del actor.
+     */
+    void destroyEntity(ActorHandle handle) {
+        m_buffer.record(m_sortKey, [handle](EntityRegistry& registry) {
+            registry.destroyEntity(handle);
+        });
+    }
+
+    /**
+     * @brief Graba que se agregue un componente a un actor.
+     * @tparam T Tipo del componente.
+     * @param handle Handle del actor.
+     * @param component Componente ya construido; se puede crear en el hilo que graba.
+     *
+     * Si el actor ya no existe cuando se aplica el comando, el componente se descarta.
+     */
+    template<typename T>
+    void addComponent(ActorHandle handle, EngineUtilities::TIntrusivePtr<T> component) {
+        m_buffer.record(m_sortKey, [handle, component = std::move(component)](EntityRegistry& registry) mutable {
+            if (registry.isValid(handle)) {
+                registry.get(handle)->addComponent(std::move(component));
+            }
+        });
+    }
+
+    /**
+     * @brief Graba que se quite un componente de un actor.
+     * @tparam T Tipo con el que se agreg el componente.
+     * @param handle Handle del actor.
+     */
+    template<typename T>
+    void removeComponent(ActorHandle handle) {
+        m_buffer.record(m_sortKey, [handle](EntityRegistry& registry) {
+            if (registry.isValid(handle)) {
+                registry.get(handle)->template removeComponent<T>();
+            }
+        });
+    }
+
+    /**
+     * @brief Clave de orden con que graba.
+     */
+    std::uint64_t getSortKey() const { return m_sortKey; }
+
+private:
+    CommandBuffer& m_buffer;  ///< Bfer del hilo que graba.
+    std::uint64_t m_sortKey;  ///< Clave de orden de la tarea.
+};
+
+/**
+ * @class CommandQueue
+ * @brief Un `CommandBuffer` por hilo del JobSystem, aplicados juntos en un punto de sincronizacin.
+ *
+ * Grabar no usa candados: cada hilo escribe en su propio bfer. Al aplicar, los comandos
+ * de todos los bferes se ordenan por clave de forma estable, as que el resultado no
+ * depende de qu hilo ejecut cada tarea mientras cada tarea use su propia clave (por
+ * ejemplo `System::getOrder()`). Los comandos de una misma tarea conservan su orden.
+ *
+ * El hilo principal y cualquier otro hilo que no sea trabajador comparten el bfer 0, as
+ * que solo el principal debe grabar desde fuera del JobSystem.
+ */
+class CommandQueue {
+public:
+    /**
+     * @brief Crea un bfer para cada hilo del JobSystem global.
+     */
+    CommandQueue();
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    /**
+     * @brief Obtiene un grabador sobre el bfer del hilo que llama.
+     * @param sortKey Clave de orden de la tarea que va a grabar.
+     * @return Grabador que pone esa clave en cada comando.
+     */
+    CommandRecorder local(std::uint64_t sortKey);
+
+    /**
+     * @brief Aplica todos los comandos grabados y vaca los bferes.
+     * @param registry Registro sobre el que se aplican.
+     * @return Nmero de comandos aplicados.
+     *
+     * Debe llamarse cuando ningn otro hilo est grabando.
+     */
+    std::size_t apply(EntityRegistry& registry);
+
+private:
+    std::vector<std::unique_ptr<CommandBuffer>> m_buffers; ///< Un bfer por hilo.
+    std::vector<CommandBuffer::Command*> m_merged;         ///< Comandos de todos los bferes, reutilizado.
+};
@@ -1,4 +1,6 @@
 #pragma once
+#include "Prerequisites.h"
+
 class Window;
 
 /**
@@ -16,6 +18,8 @@ enum ComponentType {
 	PHYSICS = 4,   ///< Componente que gestiona la fsica del objeto.
 	AUDIOSOURCE = 5,///< Componente de fuente de audio para reproducir sonidos.
 	SHAPE = 6,     ///< Componente que maneja formas geomtricas.
+	PATH_FOLLOW = 7, ///< Componente que sigue un recorrido.
+	SEEK_TARGET = 8, ///< Componente que persigue un punto.
 };
 
 /**
@@ -25,8 +29,11 @@ enum ComponentType {
  * La clase Component proporciona una interfaz genrica que define el comportamiento
  * que debe implementar cualquier componente del sistema. Los componentes son
  * actualizables y renderizables, y cada uno tiene un tipo que define su funcionalidad.
+ *
+ * El recuento de referencias vive dentro del componente (TRefCounted), por lo que
+ * se gestionan con TIntrusivePtr sin una asignacin extra por componente.
  */
-class Component {
+class Component : public EngineUtilities::TRefCounted<> {
 public:
 	/**
 	 * @brief Constructor por defecto.
@@ -68,7 +75,7 @@ public:
 	 * Este mtodo debe ser implementado por las clases derivadas para definir
 	 * cmo se debe dibujar el componente en pantalla.
 	 */
-	virtual void render(Window window) = 0;
+	virtual void render(Window& window) = 0;
 
 	/**
 	 * @brief Obtiene el tipo del componente.
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include "Prerequisites.h"
+
+/**
+ * @brief Nmero mximo de tipos de componente distintos.
+ *
+ * Cada tipo ocupa un bit de `ComponentMask`.
+ */
+constexpr std::uint32_t MAX_COMPONENT_TYPES = 64;
+
+/**
+ * @brief Mscara de bits con un bit por tipo de componente.
+ */
+using ComponentMask = std::uint64_t;
+
+/**
+ * @brief Entrega el siguiente identificador de tipo de componente libre.
+ * @return Identificador nuevo, nico en todo el programa.
+ *
+ * No se debe llamar directamente; se usa a travs de `ComponentTypeID<T>()`. Si ya se
+ * usaron los `MAX_COMPONENT_TYPES` identificadores, el tipo nuevo no cabe en
+ * `ComponentMask` y el programa termina con un error.
+ */
+inline std::uint32_t nextComponentTypeID() {
+    static std::atomic<std::uint32_t> counter{ 0 };
+    const std::uint32_t id = counter.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MAX_COMPONENT_TYPES) {
+        ERROR("ComponentTypeID", "nextComponentTypeID",
+              "more than " << MAX_COMPONENT_TYPES << " component types");
+    }
+    return id;
+}
+
+/**
+ * @brief Obtiene el identificador del tipo de componente T.
+ * @tparam T Tipo de componente.
+ * @return Identificador en el rango [0, MAX_COMPONENT_TYPES).
+ *
+ * Cada instanciacin de la plantilla guarda su propio identificador, asignado la
+ * primera vez que se consulta. Despus, obtenerlo es leer una variable esttica:
+ * no hay RTTI ni bsqueda por nombre.
+ */
+template<typename T>
+std::uint32_t ComponentTypeID() {
+    static const std::uint32_t id = nextComponentTypeID();
+    return id;
+}
+
+/**
+ * @brief Obtiene el bit de `ComponentMask` que corresponde al tipo T.
+ * @tparam T Tipo de componente.
+ * @return Mscara con un nico bit encendido.
+ */
+template<typename T>
+ComponentMask ComponentBit() {
+    return ComponentMask(1) << ComponentTypeID<T>();
+}
+
+/**
+ * @brief Cuenta los bits encendidos de una mscara.
+ * @param mask Mscara de componentes.
+ * @return Nmero de bits encendidos.
+ */
+inline std::uint32_t countComponentBits(ComponentMask mask) {
+    return static_cast<std::uint32_t>(std::bitset<MAX_COMPONENT_TYPES>(mask).count());
+}
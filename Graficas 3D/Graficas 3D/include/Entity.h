@@ -1,8 +1,11 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Component.h"
+#include "ComponentTypeID.h"
 
 class Window;
+class EntityQueryCache;
+class EntityRegistry;
 
 /**
  * @class Entity
@@ -11,6 +14,10 @@ class Window;
  * Una entidad es cualquier objeto en el juego que puede tener componentes. La clase
  * `Entity` gestiona los componentes asociados y define las interfaces para actualizar
  * y renderizar entidades en el juego.
+ *
+ * A diferencia de los componentes, no lleva recuento de referencias: el dueo de cada
+ * actor es la `THandleTable` de su `EntityRegistry`, y el resto del motor lo guarda
+ * como `ActorHandle`. Por eso no puede envolverse en un TIntrusivePtr.
  */
 class Entity {
 public:
@@ -18,9 +25,9 @@ public:
      * @brief Destructor virtual.
      *
      * Asegura que al destruir una entidad, todos sus recursos y componentes se liberen
-     * correctamente.
+     * correctamente. Si la entidad est registrada en un `EntityQueryCache`, sale de l.
      */
-    virtual ~Entity() = default;
+    virtual ~Entity();
 
     /**
      * @brief Mtodo virtual puro para actualizar la entidad.
@@ -43,46 +50,181 @@ public:
     /**
      * @brief Agrega un componente a la entidad.
      * @tparam T Tipo del componente que se va a agregar, debe derivar de Component.
-     * @param component Puntero compartido al componente que se va a agregar.
+     * @param component Puntero intrusivo al componente que se va a agregar.
      *
      * Este mtodo permite aadir un nuevo componente a la entidad. Se asegura mediante
      * `static_assert` que el tipo T sea una subclase de `Component`, para garantizar que solo
      * componentes vlidos puedan ser aadidos.
+     *
+     * El componente se registra con el identificador de tipo de T (ComponentTypeID), por lo
+     * que despus se debe pedir con ese mismo tipo. Una entidad tiene como mximo un
+     * componente de cada tipo: si ya haba uno, se reemplaza.
+     *
+     * Si la entidad est en un `EntityRegistry`, este se entera del componente nuevo (y
+     * del reemplazado), por ejemplo para conectar un `ShapeFactory` a su rbol de cajas.
      */
     template <typename T>
-    void addComponent(EngineUtilities::TSharedPointer<T> component) {
+    void addComponent(EngineUtilities::TIntrusivePtr<T> component) {
         static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
-        components.push_back(component.template dynamic_pointer_cast<Component>());
+        if (component.isNull()) {
+            return;
+        }
+        const ComponentMask bit = ComponentBit<T>();
+        const std::size_t slot = componentSlot(bit);
+        if (componentMask & bit) {
+            notifyComponentDetached(bit, *components[slot]);
+            components[slot] = std::move(component);
+            notifyComponentAttached(bit, *components[slot]);
+            return;
+        }
+        components.insert(components.begin() + slot, std::move(component));
+        const ComponentMask oldMask = componentMask;
+        componentMask |= bit;
+        notifyComponentsChanged(oldMask);
+        notifyComponentAttached(bit, *components[slot]);
+    }
+
+    /**
+     * @brief Quita un componente de la entidad.
+     * @tparam T Tipo con el que se agreg el componente.
+     * @return true si la entidad tena un componente de ese tipo.
+     */
+    template <typename T>
+    bool removeComponent() {
+        const ComponentMask bit = ComponentBit<T>();
+        if (!(componentMask & bit)) {
+            return false;
+        }
+        const std::size_t slot = componentSlot(bit);
+        notifyComponentDetached(bit, *components[slot]);
+        components.erase(components.begin() + slot);
+        const ComponentMask oldMask = componentMask;
+        componentMask &= ~bit;
+        notifyComponentsChanged(oldMask);
+        return true;
     }
 
     /**
      * @brief Obtiene un componente de la entidad.
      * @tparam T Tipo del componente que se va a obtener.
-     * @return Puntero compartido al componente, o nullptr si no se encuentra.
+     * @return Puntero intrusivo al componente, o nullptr si no se encuentra.
+     *
+     * La bsqueda es de coste constante; ver getComponentPtr.
+     */
+    template<typename T>
+    EngineUtilities::TIntrusivePtr<T> getComponent() {
+        return EngineUtilities::TIntrusivePtr<T>(getComponentPtr<T>());
+    }
+
+    /**
+     * @brief Obtiene un puntero crudo a un componente de la entidad.
+     * @tparam T Tipo del componente que se va a obtener.
+     * @return Puntero al componente, o nullptr si la entidad no tiene uno de ese tipo.
      *
-     * Busca entre los componentes de la entidad uno que coincida con el tipo proporcionado.
-     * Si lo encuentra, lo devuelve como un puntero compartido al tipo solicitado.
+     * Los componentes se guardan ordenados por identificador de tipo, as que la posicin
+     * de T es el nmero de bits encendidos en la mscara por debajo del suyo. No usa RTTI
+     * ni toca el recuento de referencias, por lo que es la forma indicada de consultar
+     * componentes en cada fotograma.
      */
     template<typename T>
-    EngineUtilities::TSharedPointer<T> getComponent() {
-        for (auto& component : components) {
-            EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-            if (specificComponent) {
-                return specificComponent;
-            }
+    T* getComponentPtr() const {
+        const ComponentMask bit = ComponentBit<T>();
+        if (!(componentMask & bit)) {
+            return nullptr;
         }
-        return EngineUtilities::TSharedPointer<T>();
+        return static_cast<T*>(components[componentSlot(bit)].get());
+    }
+
+    /**
+     * @brief Indica si la entidad tiene un componente del tipo T.
+     * @tparam T Tipo del componente.
+     * @return true si lo tiene.
+     */
+    template<typename T>
+    bool hasComponent() const {
+        return (componentMask & ComponentBit<T>()) != 0;
+    }
+
+    /**
+     * @brief Obtiene el identificador de la entidad.
+     * @return ndice del espacio que ocupa en su `EntityRegistry`, o -1 si no est registrada.
+     *
+     * El ndice se reutiliza al destruir la entidad; para referencias duraderas se debe
+     * usar el handle que entrega el registro, que adems lleva la generacin.
+     */
+    int getId() const {
+        return id;
+    }
+
+    /**
+     * @brief Indica si la entidad est activa.
+     * @return false si la entidad est marcada para destruirse.
+     */
+    bool getIsActive() const {
+        return isActive;
+    }
+
+    /**
+     * @brief Obtiene la mscara de tipos de componente de la entidad.
+     * @return Mscara con un bit encendido por cada componente presente.
+     */
+    ComponentMask getComponentMask() const {
+        return componentMask;
     }
 
 protected:
-    bool isActive; ///< Estado de la entidad, indica si est activa o no.
-    int id; ///< Identificador nico de la entidad.
+    /**
+     * @brief Quita todos los componentes de la entidad.
+     */
+    void removeAllComponents();
+
+    bool isActive = true; ///< Estado de la entidad, indica si est activa o no.
+    int id = -1; ///< Identificador nico de la entidad.
 
     /**
      * @brief Lista de componentes asociados a la entidad.
      *
      * Cada entidad puede tener varios componentes que gestionan diferentes aspectos
-     * de su comportamiento (fsica, renderizado, audio, etc.).
+     * de su comportamiento (fsica, renderizado, audio, etc.). Estn ordenados por su
+     * identificador de tipo, en correspondencia con `componentMask`.
      */
-    std::vector<EngineUtilities::TSharedPointer<Component>> components;
+    std::vector<EngineUtilities::TIntrusivePtr<Component>> components;
+
+    ComponentMask componentMask = 0; ///< Un bit por cada tipo de componente presente.
+
+private:
+    friend class EntityQueryCache;
+    friend class EntityRegistry;
+
+    /**
+     * @brief Avisa al `EntityQueryCache` de la entidad que cambi su mscara.
+     * @param oldMask Mscara antes del cambio.
+     */
+    void notifyComponentsChanged(ComponentMask oldMask);
+
+    /**
+     * @brief Avisa al `EntityRegistry` de la entidad que se agreg un componente.
+     * @param bit Bit del tipo del componente.
+     * @param component Componente agregado.
+     */
+    void notifyComponentAttached(ComponentMask bit, Component& component);
+
+    /**
+     * @brief Avisa al `EntityRegistry` de la entidad que se va a quitar un componente.
+     * @param bit Bit del tipo del componente.
+     * @param component Componente que se va a quitar; sigue vivo durante el aviso.
+     */
+    void notifyComponentDetached(ComponentMask bit, Component& component);
+
+    EntityQueryCache* queryCache = nullptr; ///< Cach de consultas donde est registrada la entidad.
+    EntityRegistry* registry = nullptr;     ///< Registro dueo de la entidad, o nullptr.
+
+    /**
+     * @brief Calcula la posicin en `components` del tipo con el bit dado.
+     * @param bit Bit del tipo de componente.
+     * @return Nmero de componentes con un identificador de tipo menor.
+     */
+    std::size_t componentSlot(ComponentMask bit) const {
+        return countComponentBits(componentMask & (bit - 1));
+    }
 };
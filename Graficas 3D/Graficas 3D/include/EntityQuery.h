@@ -0,0 +1,124 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Entity.h"
+#include <unordered_map>
+
+/**
+ * @class EntityView
+ * @brief Vista de las entidades que tienen todos los componentes Ts.
+ *
+ * Es una referencia a la lista que mantiene el `EntityQueryCache`, as que recorrerla es
+ * un recorrido lineal de punteros, sin buscar ni convertir tipos por entidad. La vista deja
+ * de ser vlida si se agregan o quitan componentes o entidades mientras se recorre.
+ *
+ * @tparam Ts Tipos de componente requeridos.
+ */
+template<typename... Ts>
+class EntityView {
+public:
+    using iterator = std::vector<Entity*>::const_iterator;
+
+    /**
+     * @brief Constructor.
+     * @param entities Lista de entidades que cumplen la consulta.
+     */
+    explicit EntityView(const std::vector<Entity*>& entities) : m_entities(&entities) {}
+
+    iterator begin() const { return m_entities->begin(); }
+    iterator end() const { return m_entities->end(); }
+    std::size_t size() const { return m_entities->size(); }
+    bool empty() const { return m_entities->empty(); }
+
+    /**
+     * @brief Llama a una funcin por cada entidad de la vista.
+     * @param function Funcin `(Entity& entity, Ts&... components)`.
+     */
+    template<typename Function>
+    void each(Function&& function) const {
+        for (Entity* entity : *m_entities) {
+            function(*entity, *entity->template getComponentPtr<Ts>()...);
+        }
+    }
+
+private:
+    const std::vector<Entity*>* m_entities; ///< Entidades que cumplen la consulta.
+};
+
+/**
+ * @class EntityQueryCache
+ * @brief Mantiene, para cada combinacin de componentes consultada, la lista de entidades que la cumplen.
+ *
+ * Las entidades registradas avisan al cach cuando cambian sus componentes con
+ * `Entity::addComponent` o `Entity::removeComponent`, y el cach actualiza solo las
+ * consultas afectadas. Una consulta nueva se llena una sola vez, la primera vez que se pide.
+ *
+ * Las entidades salen del cach automticamente al destruirse, por lo que el cach debe
+ * vivir ms que ellas.
+ */
+class EntityQueryCache {
+public:
+    EntityQueryCache();
+    ~EntityQueryCache();
+
+    EntityQueryCache(const EntityQueryCache&) = delete;
+    EntityQueryCache& operator=(const EntityQueryCache&) = delete;
+
+    /**
+     * @brief Registra una entidad.
+     * @param entity Entidad a registrar; no debe estar registrada en otro cach.
+     */
+    void addEntity(Entity& entity);
+
+    /**
+     * @brief Saca una entidad del cach.
+     * @param entity Entidad registrada.
+     */
+    void removeEntity(Entity& entity);
+
+    /**
+     * @brief Obtiene la vista de las entidades que tienen todos los componentes Ts.
+     * @tparam Ts Tipos de componente, los mismos con que se agregaron a las entidades.
+     * @return Vista sobre la lista cacheada.
+     */
+    template<typename... Ts>
+    EntityView<Ts...> view() {
+        const ComponentMask mask = (ComponentMask(0) | ... | ComponentBit<Ts>());
+        return EntityView<Ts...>(findOrCreateQuery(mask).entities);
+    }
+
+    /**
+     * @brief Nmero de entidades registradas.
+     */
+    std::size_t entityCount() const { return m_queries.at(0).entities.size(); }
+
+private:
+    friend class Entity;
+
+    /**
+     * @brief Lista de entidades de una consulta, con su posicin para quitarlas en tiempo constante.
+     */
+    struct Query {
+        ComponentMask mask = 0;                                  ///< Componentes requeridos.
+        std::vector<Entity*> entities;                           ///< Entidades que cumplen la consulta.
+        std::unordered_map<const Entity*, std::size_t> positions; ///< Posicin de cada entidad en `entities`.
+
+        bool matches(ComponentMask entityMask) const { return (entityMask & mask) == mask; }
+        void add(Entity* entity);
+        void remove(const Entity* entity);
+    };
+
+    /**
+     * @brief Actualiza las consultas afectadas por un cambio de componentes.
+     * @param entity Entidad que cambi.
+     * @param oldMask Mscara de la entidad antes del cambio.
+     */
+    void onComponentsChanged(Entity& entity, ComponentMask oldMask);
+
+    /**
+     * @brief Busca una consulta o la crea y la llena con las entidades registradas.
+     */
+    Query& findOrCreateQuery(ComponentMask mask);
+
+    /// Consultas por mscara. La de mscara 0 contiene todas las entidades registradas.
+    std::unordered_map<ComponentMask, Query> m_queries;
+};
@@ -0,0 +1,180 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Actor.h"
+#include "EntityQuery.h"
+#include "AABBTree.h"
+
+/**
+ * @brief Handle de un actor guardado en un EntityRegistry.
+ */
+using ActorHandle = EngineUtilities::THandle<Actor>;
+
+/**
+ * @class EntityRegistry
+ * @brief Dueo de los actores de la escena: les asigna identificador y los destruye por lotes.
+ *
+ * Los actores viven en un `THandleTable`, en pginas contiguas que se reservan por
+ * bloques, y se referencian con handles de ndice y generacin. Los espacios liberados se
+ * reutilizan; un handle viejo deja de ser vlido porque la generacin del espacio cambia.
+ * `Entity::id` guarda el ndice del espacio.
+ *
+ * Destruir es diferido: `destroyEntity` y `destroyEntities` solo marcan los actores como
+ * inactivos, y `flushDestroyed` los destruye todos juntos en un punto seguro del fotograma.
+ * Mientras tanto, `forEach` ya no los visita.
+ *
+ * Todos los actores creados se registran en el cach de consultas del registro, y su
+ * `ShapeFactory` se conecta al rbol de cajas del registro, que sirve para saber qu
+ * actores se ven (`queryVisible`). El registro se entera de los componentes que se
+ * agregan, reemplazan o quitan despus, as que una forma agregada ms tarde tambin
+ * entra al rbol, y una que se quita sale de l.
+ */
+class EntityRegistry {
+public:
+    EntityRegistry() = default;
+
+    /**
+     * @brief Destruye todos los actores.
+     */
+    ~EntityRegistry();
+
+    EntityRegistry(const EntityRegistry&) = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+    /**
+     * @brief Crea un actor.
+     * @param name Nombre del actor.
+     * @return Handle del actor.
+     */
+    ActorHandle createEntity(const std::string& name);
+
+    /**
+     * @brief Crea varios actores de una vez.
+     * @param count Nmero de actores.
+     * @param name Nombre de los actores.
+     * @param out Vector al que se agregan los handles creados.
+     *
+     * Reserva de una vez la memoria de todos los actores.
+     */
+    void createEntities(std::size_t count, const std::string& name, std::vector<ActorHandle>& out);
+
+    /**
+     * @brief Marca un actor para destruirse en el siguiente `flushDestroyed`.
+     * @param handle Handle del actor.
+     * @return true si el handle era vlido y el actor no estaba ya marcado.
+     */
+    bool destroyEntity(ActorHandle handle);
+
+    /**
+     * @brief Marca varios actores para destruirse en el siguiente `flushDestroyed`.
+     * @param handles Primer handle del arreglo.
+     * @param count Nmero de handles.
+     */
+    void destroyEntities(const ActorHandle* handles, std::size_t count);
+
+    /**
+     * @brief Marca varios actores para destruirse en el siguiente `flushDestroyed`.
+     * @param handles Handles de los actores.
+     */
+    void destroyEntities(const std::vector<ActorHandle>& handles) {
+        destroyEntities(handles.data(), handles.size());
+    }
+
+    /**
+     * @brief Destruye todos los actores marcados.
+     *
+     * Primero llama a `Actor::destroy` en todos y luego libera sus espacios, en lugar de
+     * alternar ambos pasos por actor.
+     */
+    void flushDestroyed();
+
+    /**
+     * @brief Destruye todos los actores, marcados o no.
+     */
+    void clear();
+
+    /**
+     * @brief Obtiene un actor.
+     * @param handle Handle del actor.
+     * @return Puntero al actor, o nullptr si el handle no es vlido. Un actor marcado
+     *         para destruirse sigue siendo accesible hasta `flushDestroyed`.
+     */
+    Actor* get(ActorHandle handle) { return m_actors.get(handle); }
+
+    /**
+     * @brief Indica si el handle se refiere a un actor activo.
+     * @param handle Handle del actor.
+     */
+    bool isValid(ActorHandle handle) const {
+        const Actor* actor = m_actors.get(handle);
+        return actor != nullptr && actor->getIsActive();
+    }
+
+    /**
+     * @brief Recorre los actores activos en orden de ndice.
+     * @param function Funcin `(ActorHandle, Actor&)`.
+     */
+    template<typename Function>
+    void forEach(Function&& function) {
+        m_actors.forEach([&function](ActorHandle handle, Actor& actor) {
+            if (actor.getIsActive()) {
+                function(handle, actor);
+            }
+        });
+    }
+
+    /**
+     * @brief Busca los actores activos cuya forma toca un rectngulo.
+     * @param rect Rectngulo en espacio de mundo, por ejemplo la vista de la ventana.
+     * @param out Vector que se vaca y se llena con los actores, en orden de ndice.
+     *
+     * Se ordenan por ndice para que el orden de dibujo no dependa de la forma del rbol.
+     * Puede incluir actores que quedan apenas afuera del rectngulo (por el margen de
+     * las cajas del rbol).
+     */
+    void queryVisible(const sf::FloatRect& rect, std::vector<Actor*>& out);
+
+    /**
+     * @brief Obtiene el rbol de cajas de las formas de los actores.
+     */
+    AABBTree& getBounds() { return m_bounds; }
+
+    /**
+     * @brief Obtiene el cach de consultas sobre los componentes de los actores.
+     */
+    EntityQueryCache& getQueries() { return m_queries; }
+
+    std::size_t size() const { return m_actors.size(); }
+    std::size_t pendingDestroyCount() const { return m_pendingDestroy.size(); }
+
+private:
+    /**
+     * @brief Asigna identificador y registra en el cach y en el rbol de cajas un actor
+     * recin creado.
+     */
+    void registerEntity(ActorHandle handle);
+
+    friend class Entity;
+
+    /**
+     * @brief Conecta al rbol de cajas la forma que se agrega a un actor.
+     * @param entity Actor del registro.
+     * @param bit Bit del tipo del componente.
+     * @param component Componente agregado.
+     */
+    void onComponentAttached(Entity& entity, ComponentMask bit, Component& component);
+
+    /**
+     * @brief Saca del rbol de cajas la forma que se quita de un actor.
+     * @param entity Actor del registro.
+     * @param bit Bit del tipo del componente.
+     * @param component Componente que se va a quitar.
+     */
+    void onComponentDetached(Entity& entity, ComponentMask bit, Component& component);
+
+    /// Consultas sobre los actores. Se declara antes que `m_actors` para destruirse despus.
+    EntityQueryCache m_queries;
+    /// Cajas de las formas. Se declara antes que `m_actors` para destruirse despus.
+    AABBTree m_bounds;
+    EngineUtilities::THandleTable<Actor> m_actors;   ///< Memoria de los actores.
+    std::vector<ActorHandle> m_pendingDestroy;       ///< Actores marcados para destruirse.
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include "Prerequisites.h"
+#include "System.h"
+#include "EntityRegistry.h"
+#include "Steering.h"
+
+/**
+ * @class FlockingSystem
+ * @brief Sistema que mueve un grupo de actores con un `SteeringGroup`.
+ *
+ * La simulacin vive en el grupo; en cada fotograma el sistema la avanza y escribe las
+ * posiciones en el componente `ShapeFactory` de cada actor. Si se le da una amenaza,
+ * pasa su posicin y su velocidad (estimada entre fotogramas) a Flee y Evade.
+ */
+class FlockingSystem : public System {
+public:
+    /**
+     * @brief Constructor.
+     * @param actors Registro de actores de la aplicacin.
+     * @param agents Actores del grupo; su posicin actual es la posicin inicial.
+     * @param params Lmites y distancias de los comportamientos.
+     * @param weights Pesos de la mezcla.
+     */
+    FlockingSystem(EntityRegistry& actors,
+                   std::vector<ActorHandle> agents,
+                   const SteeringParams& params,
+                   const SteeringWeights& weights);
+
+    /**
+     * @brief Punto al que van Seek y Arrive.
+     */
+    void setTarget(const sf::Vector2f& target) { m_group.setTarget(target); }
+
+    /**
+     * @brief Actor del que se alejan Flee y Evade.
+     */
+    void setThreat(ActorHandle threat);
+
+    /**
+     * @brief Avanza el grupo y mueve los actores.
+     * @param world World de la aplicacin (no se usa).
+     * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+     */
+    void update(World& world, float deltaTime) override;
+
+    SteeringGroup& getGroup() { return m_group; }
+
+private:
+    EntityRegistry& m_actors;             ///< Registro de actores de la aplicacin.
+    std::vector<ActorHandle> m_agents;    ///< Actor de cada agente del grupo.
+    SteeringGroup m_group;                ///< Simulacin del grupo.
+    ActorHandle m_threat;                 ///< Amenaza, o un handle invlido.
+    sf::Vector2f m_lastThreatPosition;    ///< Posicin de la amenaza en el fotograma anterior.
+    bool m_hasThreatPosition = false;     ///< Si `m_lastThreatPosition` es vlida.
+};
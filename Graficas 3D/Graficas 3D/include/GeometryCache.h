@@ -0,0 +1,115 @@
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @struct ShapeMesh
+ * @brief Geometra inmutable de una forma en espacio local.
+ *
+ * Guarda los puntos del contorno en el mismo orden que `sf::CircleShape` y
+ * `sf::RectangleShape`, y los tringulos del relleno ya armados como abanico, para
+ * que dibujar una copia solo tenga que transformarlos.
+ */
+struct ShapeMesh {
+	std::vector<sf::Vector2f> points;    ///< Puntos del contorno, en espacio local.
+	std::vector<sf::Vector2f> triangles; ///< Relleno: tres vrtices por tringulo.
+	sf::FloatRect bounds;                ///< Caja local de los puntos.
+};
+
+/**
+ * @brief Puntero compartido a una geometra del cach.
+ */
+using ShapeMeshPtr = EngineUtilities::TSharedPointer<ShapeMesh>;
+
+/**
+ * @struct ShapeMeshKey
+ * @brief Clave de una geometra: tipo de forma y sus parmetros.
+ *
+ * Para crculos y tringulos `width` es el radio y `height` no se usa; para
+ * rectngulos son el ancho y el alto. `pointCount` es el nmero de lados.
+ */
+struct ShapeMeshKey {
+	ShapeType type = ShapeType::EMPTY;
+	float width = 0.0f;
+	float height = 0.0f;
+	std::size_t pointCount = 0;
+
+	bool operator==(const ShapeMeshKey& other) const {
+		return type == other.type && width == other.width &&
+			height == other.height && pointCount == other.pointCount;
+	}
+};
+
+/**
+ * @class GeometryCache
+ * @brief Cach de geometras compartidas (flyweight) por tipo de forma y parmetros.
+ *
+ * Cada combinacin de tipo y parmetros se tesela una sola vez; todos los que la
+ * pidan comparten el mismo `ShapeMesh`. La geometra nunca se modifica despus de
+ * crearse, as que se puede leer desde cualquier hilo.
+ */
+class GeometryCache {
+public:
+	/**
+	 * @brief Obtiene la instancia global del cach.
+	 */
+	static GeometryCache& instance();
+
+	GeometryCache(const GeometryCache&) = delete;
+	GeometryCache& operator=(const GeometryCache&) = delete;
+
+	/**
+	 * @brief Obtiene la geometra de un polgono regular inscrito en un crculo.
+	 * @param radius Radio del crculo.
+	 * @param pointCount Nmero de lados.
+	 */
+	ShapeMeshPtr getCircle(float radius, std::size_t pointCount = 30);
+
+	/**
+	 * @brief Obtiene la geometra de un rectngulo con esquina en el origen.
+	 * @param size Ancho y alto.
+	 */
+	ShapeMeshPtr getRectangle(const sf::Vector2f& size);
+
+	/**
+	 * @brief Obtiene la geometra de una clave, crendola si no existe.
+	 * @param key Tipo y parmetros de la forma.
+	 * @return La geometra, o un puntero vaco si el tipo es EMPTY.
+	 */
+	ShapeMeshPtr get(const ShapeMeshKey& key);
+
+	/**
+	 * @brief Suelta las geometras que ya solo referencia el cach.
+	 * @return Nmero de geometras liberadas.
+	 */
+	std::size_t purgeUnused();
+
+	/**
+	 * @brief Suelta todas las geometras. Las que sigan en uso viven hasta que las suelten.
+	 */
+	void clear();
+
+	/**
+	 * @brief Nmero de geometras en el cach.
+	 */
+	std::size_t size() const;
+
+private:
+	GeometryCache() = default;
+
+	/**
+	 * @brief Tesela la geometra de una clave.
+	 */
+	static void build(const ShapeMeshKey& key, ShapeMesh& mesh);
+
+	/**
+	 * @brief Hash de `ShapeMeshKey`.
+	 */
+	struct KeyHash {
+		std::size_t operator()(const ShapeMeshKey& key) const;
+	};
+
+	mutable std::mutex m_mutex;                                      ///< Protege `m_meshes`.
+	std::unordered_map<ShapeMeshKey, ShapeMeshPtr, KeyHash> m_meshes; ///< Geometras por clave.
+};
@@ -0,0 +1,190 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Memory\SpinLock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @class JobCounter
+ * @brief Contador de trabajos pendientes que sirve como barrera.
+ *
+ * Cada trabajo programado con un contador lo incrementa, y lo decrementa al terminar.
+ * `JobSystem::wait` espera a que llegue a cero. Un trabajo puede programar ms
+ * trabajos con el mismo contador: como el incremento ocurre antes de que el trabajo
+ * padre termine, el contador no llega a cero antes de tiempo.
+ */
+class JobCounter {
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	/**
+	 * @brief Indica si ya terminaron todos los trabajos asociados.
+	 */
+	bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+	std::atomic<std::uint32_t> m_pending{ 0 }; ///< Trabajos sin terminar.
+};
+
+/**
+ * @struct JobWorkerStats
+ * @brief Estadsticas de un hilo del JobSystem desde el ltimo `resetStats`.
+ */
+struct JobWorkerStats {
+	std::uint64_t jobsExecuted = 0; ///< Trabajos ejecutados.
+	std::uint64_t jobsStolen = 0;   ///< Trabajos robados de la cola de otro hilo.
+	double busySeconds = 0.0;       ///< Tiempo ejecutando trabajos.
+	double utilization = 0.0;       ///< Fraccin del tiempo transcurrido que estuvo ocupado.
+};
+
+/**
+ * @class JobSystem
+ * @brief Conjunto fijo de hilos trabajadores con colas propias y robo de trabajo.
+ *
+ * Es el nico lugar donde el motor debe lanzar trabajo en paralelo (sistemas,
+ * culling, construccin de vrtices, carga de recursos). Cada trabajador tiene su cola:
+ * toma trabajos del final (el ms reciente, que suele tener sus datos en cach) y, si
+ * est vaca, roba del principio de la cola de otro. Los hilos que no son trabajadores,
+ * como el principal, comparten una cola extra.
+ *
+ * Un hilo que llama a `wait` no se queda bloqueado: ejecuta trabajos pendientes hasta
+ * que el contador llega a cero.
+ */
+class JobSystem {
+public:
+	/**
+	 * @brief Obtiene la instancia global.
+	 *
+	 * La primera llamada crea un trabajador por ncleo, menos el del hilo principal.
+	 */
+	static JobSystem& instance();
+
+	/**
+	 * @brief Crea el sistema con un nmero fijo de trabajadores.
+	 * @param workerCount Nmero de hilos trabajadores (al menos uno).
+	 */
+	explicit JobSystem(std::size_t workerCount);
+
+	/**
+	 * @brief Termina los trabajadores. Los trabajos an en cola se descartan.
+	 */
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/**
+	 * @brief Programa un trabajo.
+	 * @param task Funcin a ejecutar.
+	 * @param counter Contador opcional que se decrementa cuando el trabajo termina.
+	 */
+	void schedule(std::function<void()> task, JobCounter* counter = nullptr);
+
+	/**
+	 * @brief Espera a que terminen los trabajos de un contador, ejecutando trabajos mientras tanto.
+	 * @param counter Contador a esperar.
+	 */
+	void wait(const JobCounter& counter);
+
+	/**
+	 * @brief Ejecuta una funcin sobre un rango de ndices repartido entre los hilos.
+	 * @param count Nmero de ndices; se recorre [0, count).
+	 * @param grain ndices por trabajo.
+	 * @param function Funcin `(std::size_t begin, std::size_t end)` que procesa un subrango.
+	 *
+	 * Regresa cuando se proces todo el rango. Si el rango cabe en un solo trabajo se
+	 * ejecuta directamente en el hilo que llama.
+	 */
+	template<typename Function>
+	void parallelFor(std::size_t count, std::size_t grain, Function&& function) {
+		grain = std::max<std::size_t>(grain, 1);
+		if (count <= grain) {
+			if (count > 0) {
+				function(std::size_t(0), count);
+			}
+			return;
+		}
+
+		JobCounter counter;
+		for (std::size_t begin = 0; begin < count; begin += grain) {
+			const std::size_t end = std::min(begin + grain, count);
+			schedule([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+		wait(counter);
+	}
+
+	/**
+	 * @brief Nmero de hilos trabajadores.
+	 */
+	std::size_t workerCount() const { return m_threads.size(); }
+
+	/**
+	 * @brief ndice del hilo que llama.
+	 * @return 0 para los hilos externos (como el principal), 1..workerCount() para los trabajadores.
+	 *
+	 * Sirve para indexar datos por hilo, como los bferes de comandos.
+	 */
+	std::size_t currentThreadIndex() const { return currentQueue(); }
+
+	/**
+	 * @brief Obtiene las estadsticas de un hilo.
+	 * @param index 0 para los hilos externos (como el principal), 1..workerCount() para los trabajadores.
+	 * @return Estadsticas desde el ltimo `resetStats`.
+	 */
+	JobWorkerStats getStats(std::size_t index) const;
+
+	/**
+	 * @brief Reinicia las estadsticas de todos los hilos.
+	 */
+	void resetStats();
+
+	/**
+	 * @brief Escribe las estadsticas de todos los hilos.
+	 * @param os Flujo de salida.
+	 */
+	void dumpStats(std::ostream& os) const;
+
+private:
+	/**
+	 * @brief Trabajo en cola.
+	 */
+	struct Job {
+		std::function<void()> task;   ///< Funcin a ejecutar.
+		JobCounter* counter = nullptr; ///< Contador a decrementar al terminar.
+	};
+
+	/**
+	 * @brief Cola y estadsticas de un hilo.
+	 */
+	struct Queue {
+		EngineUtilities::SpinLock lock;               ///< Protege `jobs`.
+		std::deque<Job> jobs;                         ///< Trabajos pendientes.
+		std::atomic<std::uint64_t> jobsExecuted{ 0 }; ///< Trabajos ejecutados.
+		std::atomic<std::uint64_t> jobsStolen{ 0 };   ///< Trabajos robados.
+		std::atomic<std::uint64_t> busyNanoseconds{ 0 }; ///< Tiempo ocupado.
+	};
+
+	void workerLoop(std::size_t index);
+	bool tryRunJob(std::size_t index);
+	bool popLocal(std::size_t index, Job& job);
+	bool steal(std::size_t thief, Job& job);
+	void execute(std::size_t index, Job& job);
+	std::size_t currentQueue() const;
+
+	std::vector<std::unique_ptr<Queue>> m_queues; ///< Cola 0 para hilos externos, luego una por trabajador.
+	std::vector<std::thread> m_threads;           ///< Hilos trabajadores.
+	std::atomic<std::size_t> m_queuedJobs{ 0 };   ///< Trabajos en alguna cola.
+	std::atomic<bool> m_stopping{ false };        ///< Indica a los trabajadores que terminen.
+	std::mutex m_sleepMutex;                      ///< Mutex para dormir a los trabajadores.
+	std::condition_variable m_wake;               ///< Despierta trabajadores cuando llega trabajo.
+	std::chrono::steady_clock::time_point m_statsStart; ///< Inicio del periodo de estadsticas.
+};
@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Asignador lineal para datos temporales de un fotograma.
+	 *
+	 * Reserva un nico bfer al crearse y entrega memoria avanzando un desplazamiento:
+	 * cada asignacin es una suma y una comparacin, y no existe liberacin individual.
+	 * Toda la memoria se recupera de golpe con reset(), que se llama al inicio de cada
+	 * iteracin del bucle principal.
+	 *
+	 * Si el bfer se agota, la asignacin no falla: se reserva un bloque extra del
+	 * asignador global que se libera en el siguiente reset(). Estos desbordes se
+	 * cuentan, y la marca de agua mxima incluye los bytes pedidos en total, de modo
+	 * que sirve para dimensionar el bfer.
+	 *
+	 * No es seguro entre hilos; cada hilo debe usar su propia arena.
+	 */
+	class FrameArena
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param capacityBytes Tamao del bfer principal en bytes.
+		 */
+		explicit FrameArena(std::size_t capacityBytes)
+			: m_buffer(static_cast<unsigned char*>(::operator new(capacityBytes))),
+			  m_capacity(capacityBytes) {}
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		/**
+		 * @brief Destructor.
+		 *
+		 * Libera el bfer principal y los bloques de desborde.
+		 */
+		~FrameArena()
+		{
+			releaseOverflow();
+			::operator delete(m_buffer);
+		}
+
+		/**
+		 * @brief Reserva memoria dentro de la arena.
+		 *
+		 * @param size Nmero de bytes.
+		 * @param alignment Alineacin requerida (potencia de dos).
+		 * @return Puntero a memoria sin inicializar, vlida hasta el siguiente reset().
+		 */
+		void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+		{
+			std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer);
+			std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+			std::size_t newOffset = static_cast<std::size_t>(aligned - base) + size;
+
+			m_requested += size;
+			++m_allocationCount;
+			if (newOffset <= m_capacity)
+			{
+				m_offset = newOffset;
+				return reinterpret_cast<void*>(aligned);
+			}
+
+			// Bfer agotado: bloque de desborde que vive hasta el siguiente reset().
+			void* block = ::operator new(size, std::align_val_t(alignment));
+			m_overflow.push_back({ block, alignment });
+			++m_overflowCount;
+			return block;
+		}
+
+		/**
+		 * @brief Reserva memoria para count objetos de tipo T.
+		 *
+		 * @param count Nmero de objetos.
+		 * @return Puntero a memoria sin inicializar.
+		 */
+		template<typename T>
+		T* allocateArray(std::size_t count)
+		{
+			return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		/**
+		 * @brief Recupera toda la memoria de la arena.
+		 *
+		 * Los objetos no se destruyen: la arena solo debe guardar datos triviales o
+		 * contenedores que ya hayan sido destruidos.
+		 */
+		void reset()
+		{
+			if (m_requested > m_highWaterMark)
+			{
+				m_highWaterMark = m_requested;
+			}
+			releaseOverflow();
+			m_offset = 0;
+			m_requested = 0;
+			m_allocationCount = 0;
+		}
+
+		/**
+		 * @brief Obtener el tamao del bfer principal.
+		 */
+		std::size_t capacity() const { return m_capacity; }
+
+		/**
+		 * @brief Obtener los bytes usados del bfer principal en el fotograma actual.
+		 */
+		std::size_t used() const { return m_offset; }
+
+		/**
+		 * @brief Obtener el nmero de asignaciones del fotograma actual.
+		 */
+		std::size_t allocationCount() const { return m_allocationCount; }
+
+		/**
+		 * @brief Obtener el mximo de bytes pedidos en un solo fotograma.
+		 */
+		std::size_t highWaterMark() const
+		{
+			return m_requested > m_highWaterMark ? m_requested : m_highWaterMark;
+		}
+
+		/**
+		 * @brief Obtener cuntas asignaciones no cupieron en el bfer principal.
+		 */
+		std::size_t overflowCount() const { return m_overflowCount; }
+
+	private:
+		/**
+		 * @brief Bloque reservado fuera del bfer principal.
+		 */
+		struct OverflowBlock
+		{
+			void* memory;          ///< Memoria reservada.
+			std::size_t alignment; ///< Alineacin usada al reservar.
+		};
+
+		/**
+		 * @brief Libera los bloques de desborde.
+		 */
+		void releaseOverflow()
+		{
+			for (const OverflowBlock& block : m_overflow)
+			{
+				::operator delete(block.memory, std::align_val_t(block.alignment));
+			}
+			m_overflow.clear();
+		}
+
+		unsigned char* m_buffer;              ///< Bfer principal.
+		std::size_t m_capacity;               ///< Tamao del bfer principal.
+		std::size_t m_offset = 0;             ///< Siguiente byte libre del bfer principal.
+		std::size_t m_requested = 0;          ///< Bytes pedidos en el fotograma actual.
+		std::size_t m_allocationCount = 0;    ///< Asignaciones del fotograma actual.
+		std::size_t m_highWaterMark = 0;      ///< Mximo de bytes pedidos en un fotograma.
+		std::size_t m_overflowCount = 0;      ///< Asignaciones que no cupieron (acumulado).
+		std::vector<OverflowBlock> m_overflow; ///< Bloques de desborde del fotograma actual.
+	};
+
+	/**
+	 * @brief Adaptador compatible con la STL que reserva en una FrameArena.
+	 *
+	 * Permite usar contenedores como std::vector con memoria del fotograma actual.
+	 * deallocate no hace nada: la memoria se recupera con FrameArena::reset(), as
+	 * que el contenedor debe destruirse antes de ese reset.
+	 *
+	 * @tparam T Tipo de los elementos.
+	 */
+	template<typename T>
+	class TArenaAllocator
+	{
+	public:
+		using value_type = T; ///< Tipo de los elementos.
+
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param arena Arena de la que se reserva la memoria.
+		 */
+		explicit TArenaAllocator(FrameArena& arena) : m_arena(&arena) {}
+
+		/**
+		 * @brief Constructor de conversin entre tipos de elemento (rebind).
+		 */
+		template<typename U>
+		TArenaAllocator(const TArenaAllocator<U>& other) : m_arena(other.arena()) {}
+
+		/**
+		 * @brief Reserva memoria para count elementos.
+		 */
+		T* allocate(std::size_t count) { return m_arena->allocateArray<T>(count); }
+
+		/**
+		 * @brief No libera nada; la arena se recupera completa en reset().
+		 */
+		void deallocate(T*, std::size_t) {}
+
+		/**
+		 * @brief Obtener la arena asociada.
+		 */
+		FrameArena* arena() const { return m_arena; }
+
+	private:
+		FrameArena* m_arena; ///< Arena de la que se reserva la memoria.
+	};
+
+	template<typename T, typename U>
+	bool operator==(const TArenaAllocator<T>& a, const TArenaAllocator<U>& b) { return a.arena() == b.arena(); }
+
+	template<typename T, typename U>
+	bool operator!=(const TArenaAllocator<T>& a, const TArenaAllocator<U>& b) { return a.arena() != b.arena(); }
+
+	/**
+	 * @brief std::vector cuya memoria vive en una FrameArena.
+	 */
+	template<typename T>
+	using TFrameVector = std::vector<T, TArenaAllocator<T>>;
+}
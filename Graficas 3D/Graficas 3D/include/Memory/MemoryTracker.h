@@ -0,0 +1,228 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+/**
+ * @file MemoryTracker.h
+ * @brief Telemetra opcional de memoria por tipo para los punteros de EngineUtilities.
+ *
+ * Se activa definiendo GALVAN_MEMORY_TRACKING en las definiciones del preprocesador
+ * del proyecto. Sin esa definicin, todas las macros MEMORY_TRACK_* se expanden a
+ * nada y no queda ningn costo en el cdigo generado.
+ *
+ * Con la telemetra activa, cada tipo registra: objetos vivos, bytes vivos, pico de
+ * bytes, asignaciones y liberaciones totales, y asignaciones y liberaciones del
+ * fotograma actual. Los puntos de registro son las funciones de creacin y los
+ * dueos de la memoria: bloques de control de TSharedPointer, TUniquePtr con el
+ * borrador por defecto, MakeIntrusive y TRefCounted, TPoolAllocator y THandleTable.
+ */
+
+#ifdef GALVAN_MEMORY_TRACKING
+
+#include <atomic>
+#include <cstddef>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Contadores de memoria de un tipo.
+	 *
+	 * Todos son atmicos para que los hilos de trabajo puedan registrar sin candados.
+	 */
+	struct MemoryTypeStats
+	{
+		explicit MemoryTypeStats(const char* typeName) : name(typeName) {}
+
+		std::string name;                          ///< Nombre del tipo (typeid).
+		std::atomic<long long> liveCount{ 0 };     ///< Objetos vivos.
+		std::atomic<long long> liveBytes{ 0 };     ///< Bytes vivos.
+		std::atomic<long long> peakBytes{ 0 };     ///< Mximo de bytes vivos.
+		std::atomic<long long> totalAllocs{ 0 };   ///< Asignaciones desde el inicio.
+		std::atomic<long long> totalFrees{ 0 };    ///< Liberaciones desde el inicio.
+		std::atomic<long long> frameAllocs{ 0 };   ///< Asignaciones del fotograma actual.
+		std::atomic<long long> frameFrees{ 0 };    ///< Liberaciones del fotograma actual.
+
+		/**
+		 * @brief Registra una asignacin.
+		 *
+		 * @param bytes Tamao de la asignacin.
+		 */
+		void onAllocate(std::size_t bytes)
+		{
+			liveCount.fetch_add(1, std::memory_order_relaxed);
+			totalAllocs.fetch_add(1, std::memory_order_relaxed);
+			frameAllocs.fetch_add(1, std::memory_order_relaxed);
+			long long live = liveBytes.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed)
+				+ static_cast<long long>(bytes);
+			long long peak = peakBytes.load(std::memory_order_relaxed);
+			while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		/**
+		 * @brief Registra una liberacin.
+		 *
+		 * @param bytes Tamao de la liberacin.
+		 */
+		void onFree(std::size_t bytes)
+		{
+			liveCount.fetch_sub(1, std::memory_order_relaxed);
+			totalFrees.fetch_add(1, std::memory_order_relaxed);
+			frameFrees.fetch_add(1, std::memory_order_relaxed);
+			liveBytes.fetch_sub(static_cast<long long>(bytes), std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * @brief Registro global de la telemetra de memoria.
+	 */
+	class MemoryTracker
+	{
+	public:
+		/**
+		 * @brief Obtener el registro global.
+		 */
+		static MemoryTracker& instance()
+		{
+			static MemoryTracker tracker;
+			return tracker;
+		}
+
+		/**
+		 * @brief Obtener los contadores de T, registrndolos en el primer uso.
+		 */
+		template<typename T>
+		static MemoryTypeStats& statsFor()
+		{
+			static MemoryTypeStats& stats = instance().registerType(typeid(T).name());
+			return stats;
+		}
+
+		/**
+		 * @brief Reinicia los contadores por fotograma de todos los tipos.
+		 *
+		 * Se llama al inicio de cada iteracin del bucle principal.
+		 */
+		void beginFrame()
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			for (auto& stats : m_types)
+			{
+				stats->frameAllocs.store(0, std::memory_order_relaxed);
+				stats->frameFrees.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * @brief Escribe una tabla con los contadores actuales de todos los tipos.
+		 *
+		 * @param os Flujo de salida.
+		 */
+		void dumpSnapshot(std::ostream& os)
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			long long totalLive = 0;
+			os << "[MEMORY SNAPSHOT]\n"
+				<< std::setw(10) << "live" << std::setw(12) << "bytes" << std::setw(12) << "peak"
+				<< std::setw(10) << "allocs" << std::setw(10) << "frees"
+				<< std::setw(8) << "f.alloc" << std::setw(8) << "f.free" << "  type\n";
+			for (auto& stats : m_types)
+			{
+				totalLive += stats->liveBytes.load(std::memory_order_relaxed);
+				os << std::setw(10) << stats->liveCount.load(std::memory_order_relaxed)
+					<< std::setw(12) << stats->liveBytes.load(std::memory_order_relaxed)
+					<< std::setw(12) << stats->peakBytes.load(std::memory_order_relaxed)
+					<< std::setw(10) << stats->totalAllocs.load(std::memory_order_relaxed)
+					<< std::setw(10) << stats->totalFrees.load(std::memory_order_relaxed)
+					<< std::setw(8) << stats->frameAllocs.load(std::memory_order_relaxed)
+					<< std::setw(8) << stats->frameFrees.load(std::memory_order_relaxed)
+					<< "  " << stats->name << "\n";
+			}
+			os << "total live bytes: " << totalLive << "\n";
+		}
+
+	private:
+		MemoryTracker() = default;
+
+		/**
+		 * @brief Crea los contadores de un tipo nuevo.
+		 */
+		MemoryTypeStats& registerType(const char* name)
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_types.push_back(std::make_unique<MemoryTypeStats>(name));
+			return *m_types.back();
+		}
+
+		std::mutex m_mutex;                                   ///< Protege la lista de tipos.
+		std::vector<std::unique_ptr<MemoryTypeStats>> m_types; ///< Contadores registrados.
+	};
+}
+
+/**
+ * @brief Registra una asignacin de bytes para el tipo Type.
+ *
+ * Type no debe contener comas; usar un alias si es una plantilla con varios parmetros.
+ */
+#define MEMORY_TRACK_ALLOC(Type, bytes) \
+    ::EngineUtilities::MemoryTracker::statsFor<Type>().onAllocate(bytes)
+
+/**
+ * @brief Registra una liberacin de bytes para el tipo Type.
+ */
+#define MEMORY_TRACK_FREE(Type, bytes) \
+    ::EngineUtilities::MemoryTracker::statsFor<Type>().onFree(bytes)
+
+/**
+ * @brief Reinicia los contadores por fotograma.
+ */
+#define MEMORY_TRACK_BEGIN_FRAME() \
+    ::EngineUtilities::MemoryTracker::instance().beginFrame()
+
+/**
+ * @brief Escribe la tabla de telemetra en el flujo os.
+ */
+#define MEMORY_TRACK_DUMP(os) \
+    ::EngineUtilities::MemoryTracker::instance().dumpSnapshot(os)
+
+#else
+
+#define MEMORY_TRACK_ALLOC(Type, bytes) ((void)0)
+#define MEMORY_TRACK_FREE(Type, bytes) ((void)0)
+#define MEMORY_TRACK_BEGIN_FRAME() ((void)0)
+#define MEMORY_TRACK_DUMP(os) ((void)0)
+
+#endif
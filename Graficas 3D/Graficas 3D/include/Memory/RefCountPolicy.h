@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <atomic>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Poltica de recuento de referencias para un solo hilo.
+	 *
+	 * Utiliza un entero simple como contador. Es la ruta rpida para objetos que
+	 * nunca salen del hilo principal: cada copia o destruccin es un incremento o
+	 * decremento normal, sin instrucciones atmicas ni barreras de memoria.
+	 */
+	struct SingleThreadPolicy
+	{
+		using CounterType = int; ///< Tipo del contador de referencias.
+
+		/**
+		 * @brief Incrementa el contador.
+		 *
+		 * @param counter Contador a incrementar.
+		 */
+		static void increment(CounterType& counter) { ++counter; }
+
+		/**
+		 * @brief Decrementa el contador.
+		 *
+		 * @param counter Contador a decrementar.
+		 * @return true si el contador lleg a cero y el objeto debe liberarse.
+		 */
+		static bool decrement(CounterType& counter) { return --counter == 0; }
+
+		/**
+		 * @brief Incrementa el contador solo si no es cero.
+		 *
+		 * @param counter Contador a incrementar.
+		 * @return true si se pudo incrementar.
+		 */
+		static bool incrementIfNotZero(CounterType& counter)
+		{
+			if (counter == 0)
+			{
+				return false;
+			}
+			++counter;
+			return true;
+		}
+
+		/**
+		 * @brief Lee el valor actual del contador.
+		 *
+		 * @param counter Contador a leer.
+		 * @return Valor actual del contador.
+		 */
+		static int load(const CounterType& counter) { return counter; }
+	};
+
+	/**
+	 * @brief Poltica de recuento de referencias segura entre hilos.
+	 *
+	 * Utiliza un std::atomic<int> como contador. Los incrementos son relajados,
+	 * ya que quien copia ya posee una referencia vlida. El decremento usa orden
+	 * release, y el hilo que libera la ltima referencia ejecuta una barrera
+	 * acquire antes de destruir el objeto, de modo que todas las escrituras
+	 * hechas por otros hilos sean visibles para el destructor.
+	 */
+	struct ThreadSafePolicy
+	{
+		using CounterType = std::atomic<int>; ///< Tipo del contador de referencias.
+
+		/**
+		 * @brief Incrementa el contador de forma atmica.
+		 *
+		 * @param counter Contador a incrementar.
+		 */
+		static void increment(CounterType& counter)
+		{
+			counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Decrementa el contador de forma atmica.
+		 *
+		 * @param counter Contador a decrementar.
+		 * @return true si el contador lleg a cero y el objeto debe liberarse.
+		 */
+		static bool decrement(CounterType& counter)
+		{
+			if (counter.fetch_sub(1, std::memory_order_release) == 1)
+			{
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Incrementa el contador de forma atmica solo si no es cero.
+		 *
+		 * Permite que un TWeakPointer obtenga una referencia fuerte aunque otro hilo
+		 * est soltando la ltima al mismo tiempo: si el contador ya lleg a cero el
+		 * objeto se est destruyendo y no se resucita.
+		 *
+		 * @param counter Contador a incrementar.
+		 * @return true si se pudo incrementar.
+		 */
+		static bool incrementIfNotZero(CounterType& counter)
+		{
+			int current = counter.load(std::memory_order_relaxed);
+			while (current != 0)
+			{
+				if (counter.compare_exchange_weak(current, current + 1,
+					std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Lee el valor actual del contador.
+		 *
+		 * @param counter Contador a leer.
+		 * @return Valor actual del contador.
+		 */
+		static int load(const CounterType& counter)
+		{
+			return counter.load(std::memory_order_acquire);
+		}
+	};
+}
@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <atomic>
+#include <thread>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Candado de espera activa para secciones crticas muy cortas.
+	 *
+	 * Sin contencin cuesta un solo intercambio atmico, bastante menos que un
+	 * std::mutex. Solo debe proteger operaciones de unas pocas instrucciones,
+	 * como sacar o devolver un bloque de una lista libre.
+	 */
+	class SpinLock
+	{
+	public:
+		SpinLock() = default;
+		SpinLock(const SpinLock&) = delete;
+		SpinLock& operator=(const SpinLock&) = delete;
+
+		/**
+		 * @brief Adquiere el candado, cediendo el procesador mientras est ocupado.
+		 */
+		void lock()
+		{
+			while (m_flag.test_and_set(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		/**
+		 * @brief Intenta adquirir el candado sin esperar.
+		 *
+		 * @return true si se adquiri el candado.
+		 */
+		bool try_lock() { return !m_flag.test_and_set(std::memory_order_acquire); }
+
+		/**
+		 * @brief Libera el candado.
+		 */
+		void unlock() { m_flag.clear(std::memory_order_release); }
+
+	private:
+		std::atomic_flag m_flag = ATOMIC_FLAG_INIT; ///< Estado del candado.
+	};
+}
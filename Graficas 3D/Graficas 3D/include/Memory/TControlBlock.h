@@ -0,0 +1,239 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <new>
+#include <utility>
+#include "MemoryTracker.h"
+#include "RefCountPolicy.h"
+#include "TPoolAllocator.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Etiqueta para adoptar una referencia ya contada sin incrementarla.
+	 */
+	struct AdoptReference {};
+
+	/**
+	 * @brief Bloque de control compartido por todos los TSharedPointer de un objeto.
+	 *
+	 * Guarda dos recuentos: el de referencias fuertes (TSharedPointer), que mantiene
+	 * vivo al objeto, y el de referencias dbiles (TWeakPointer), que mantiene vivo
+	 * al bloque. Todas las referencias fuertes juntas cuentan como una sola dbil,
+	 * as el bloque se libera cuando desaparece la ltima referencia de cualquier tipo
+	 * y un TWeakPointer siempre puede consultar el bloque sin leer memoria liberada.
+	 *
+	 * Las clases derivadas deciden dnde vive el objeto: en una asignacin aparte
+	 * (TPointerControlBlock) o dentro del mismo bloque (TInplaceControlBlock).
+	 *
+	 * @tparam RefCountPolicy Poltica del recuento de referencias.
+	 */
+	template<typename RefCountPolicy>
+	class ControlBlockBase
+	{
+	public:
+		using CounterType = typename RefCountPolicy::CounterType; ///< Tipo del contador de referencias.
+
+		ControlBlockBase() : strongCount(1), weakCount(1) {}
+		ControlBlockBase(const ControlBlockBase&) = delete;
+		ControlBlockBase& operator=(const ControlBlockBase&) = delete;
+
+		/**
+		 * @brief Agrega una referencia fuerte.
+		 */
+		void addStrong() { RefCountPolicy::increment(strongCount); }
+
+		/**
+		 * @brief Intenta agregar una referencia fuerte desde una dbil.
+		 *
+		 * @return true si el objeto segua vivo y se agreg la referencia.
+		 */
+		bool tryAddStrong() { return RefCountPolicy::incrementIfNotZero(strongCount); }
+
+		/**
+		 * @brief Suelta una referencia fuerte.
+		 *
+		 * Si era la ltima, destruye el objeto y suelta la referencia dbil que
+		 * representaba a todas las fuertes.
+		 */
+		void releaseStrong()
+		{
+			if (RefCountPolicy::decrement(strongCount))
+			{
+				destroyObject();
+				releaseWeak();
+			}
+		}
+
+		/**
+		 * @brief Agrega una referencia dbil.
+		 */
+		void addWeak() { RefCountPolicy::increment(weakCount); }
+
+		/**
+		 * @brief Suelta una referencia dbil.
+		 *
+		 * Si era la ltima, libera la memoria del bloque.
+		 */
+		void releaseWeak()
+		{
+			if (RefCountPolicy::decrement(weakCount))
+			{
+				deallocate();
+			}
+		}
+
+		/**
+		 * @brief Obtener el nmero de referencias fuertes.
+		 *
+		 * @return Recuento de referencias actual.
+		 */
+		int useCount() const { return RefCountPolicy::load(strongCount); }
+
+	protected:
+		virtual ~ControlBlockBase() = default;
+
+		/**
+		 * @brief Destruye el objeto gestionado sin liberar el bloque.
+		 */
+		virtual void destroyObject() = 0;
+
+		/**
+		 * @brief Libera la memoria del bloque.
+		 */
+		virtual void deallocate() = 0;
+
+	private:
+		CounterType strongCount; ///< Recuento de referencias fuertes.
+		CounterType weakCount;   ///< Recuento de referencias dbiles (+1 mientras haya fuertes).
+	};
+
+	/**
+	 * @brief Bloque de control para un objeto creado aparte con new.
+	 *
+	 * Es el bloque que usa el constructor TSharedPointer(T*), donde el objeto ya
+	 * existe antes de crear el puntero compartido.
+	 */
+	template<typename T, typename RefCountPolicy>
+	class TPointerControlBlock : public ControlBlockBase<RefCountPolicy>
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
+		 */
+		explicit TPointerControlBlock(T* rawPtr) : ptr(rawPtr)
+		{
+			MEMORY_TRACK_ALLOC(T, sizeof(T));
+		}
+
+	protected:
+		void destroyObject() override
+		{
+			MEMORY_TRACK_FREE(T, sizeof(T));
+			delete ptr;
+			ptr = nullptr;
+		}
+
+		void deallocate() override
+		{
+			delete this;
+		}
+
+	private:
+		T* ptr; ///< Puntero al objeto gestionado.
+	};
+
+	/**
+	 * @brief Bloque de control que contiene al objeto en su interior.
+	 *
+	 * Lo usa MakeShared: el contador y el objeto comparten una sola asignacin,
+	 * lo que reduce a la mitad las llamadas al asignador y deja el contador en la
+	 * misma lnea de cach que el inicio del objeto. El destructor de T se ejecuta
+	 * con la ltima referencia fuerte; la memoria se devuelve con la ltima dbil.
+	 */
+	template<typename T, typename RefCountPolicy>
+	class TInplaceControlBlock : public ControlBlockBase<RefCountPolicy>
+	{
+	public:
+		/**
+		 * @brief Constructor que construye el objeto dentro del bloque.
+		 *
+		 * @param args Argumentos reenviados al constructor de T.
+		 */
+		template<typename... Args>
+		explicit TInplaceControlBlock(Args&&... args)
+		{
+			::new (static_cast<void*>(&storage)) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Obtener el puntero al objeto almacenado.
+		 *
+		 * @return Puntero al objeto gestionado.
+		 */
+		T* get() { return std::launder(reinterpret_cast<T*>(&storage)); }
+
+	protected:
+		void destroyObject() override
+		{
+			get()->~T();
+		}
+
+		void deallocate() override
+		{
+			MEMORY_TRACK_FREE(TInplaceControlBlock, sizeof(TInplaceControlBlock));
+			delete this;
+		}
+
+	private:
+		alignas(T) unsigned char storage[sizeof(T)]; ///< Memoria donde vive el objeto.
+	};
+
+	/**
+	 * @brief Bloque de control con el objeto dentro, reservado en un TPoolAllocator.
+	 *
+	 * Lo usa AllocateShared: igual que TInplaceControlBlock, pero la memoria del
+	 * bloque sale del pool de este tipo de bloque en lugar del asignador global.
+	 */
+	template<typename T, typename RefCountPolicy>
+	class TPooledControlBlock : public TInplaceControlBlock<T, RefCountPolicy>
+	{
+	public:
+		using Pool = TPoolAllocator<TPooledControlBlock>; ///< Pool del que salen estos bloques.
+
+		using TInplaceControlBlock<T, RefCountPolicy>::TInplaceControlBlock;
+
+	protected:
+		void deallocate() override
+		{
+			Pool::instance().destroy(this);
+		}
+	};
+}
@@ -0,0 +1,293 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "MemoryTracker.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Referencia ligera a un objeto guardado en un THandleTable.
+	 *
+	 * Un handle es un ndice de 32 bits dentro de la tabla ms la generacin del
+	 * espacio en el momento de crearlo. Copiarlo cuesta lo mismo que copiar un
+	 * entero de 64 bits y no toca ningn contador. Si el objeto se destruye, la
+	 * generacin del espacio cambia y el handle queda obsoleto: THandleTable::get
+	 * devuelve nullptr en lugar de un objeto distinto que reutilice el espacio.
+	 *
+	 * La generacin 0 nunca se asigna, as que un handle construido por defecto es invlido.
+	 *
+	 * @tparam T Tipo del objeto referenciado (solo sirve para no mezclar handles).
+	 */
+	template<typename T>
+	struct THandle
+	{
+		std::uint32_t index = 0;      ///< Posicin del objeto en la tabla.
+		std::uint32_t generation = 0; ///< Generacin del espacio al crear el handle.
+
+		/**
+		 * @brief Comprobar si el handle fue asignado alguna vez.
+		 *
+		 * No indica si el objeto sigue vivo; para eso se usa THandleTable::isValid.
+		 */
+		bool isNull() const { return generation == 0; }
+
+		bool operator==(const THandle& other) const
+		{
+			return index == other.index && generation == other.generation;
+		}
+
+		bool operator!=(const THandle& other) const { return !(*this == other); }
+	};
+
+	/**
+	 * @brief Tabla de espacios que posee objetos de tipo T y los entrega por handle.
+	 *
+	 * Es el almacenamiento central de los objetos: la tabla los construye, los
+	 * destruye y los guarda en pginas de tamao fijo, por lo que nunca se mueven
+	 * y los punteros obtenidos con get() siguen siendo vlidos mientras el objeto
+	 * viva. Las generaciones se guardan en un arreglo aparte para que validar un
+	 * handle solo lea un entero.
+	 *
+	 * Buscar, crear y destruir son O(1). Los espacios liberados se reutilizan.
+	 * No es segura entre hilos.
+	 *
+	 * @tparam T Tipo de los objetos guardados.
+	 * @tparam PageSize Nmero de objetos por pgina.
+	 */
+	template<typename T, std::size_t PageSize = 256>
+	class THandleTable
+	{
+	public:
+		using Handle = THandle<T>; ///< Tipo de handle que entrega la tabla.
+
+		THandleTable() = default;
+		THandleTable(const THandleTable&) = delete;
+		THandleTable& operator=(const THandleTable&) = delete;
+
+		/**
+		 * @brief Destructor.
+		 *
+		 * Destruye todos los objetos vivos.
+		 */
+		~THandleTable()
+		{
+			clear();
+		}
+
+		/**
+		 * @brief Construye un objeto nuevo dentro de la tabla.
+		 *
+		 * @param args Argumentos reenviados al constructor de T.
+		 * @return Handle al objeto creado.
+		 */
+		template<typename... Args>
+		Handle create(Args&&... args)
+		{
+			std::uint32_t index;
+			if (!m_freeIndices.empty())
+			{
+				index = m_freeIndices.back();
+				m_freeIndices.pop_back();
+			}
+			else
+			{
+				index = static_cast<std::uint32_t>(m_generations.size());
+				if (index / PageSize >= m_pages.size())
+				{
+					m_pages.push_back(std::unique_ptr<Page>(new Page));
+				}
+				m_generations.push_back(1);
+				m_alive.push_back(0);
+			}
+
+			::new (static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+			MEMORY_TRACK_ALLOC(T, sizeof(T));
+			m_alive[index] = 1;
+			++m_size;
+			return Handle{ index, m_generations[index] };
+		}
+
+		/**
+		 * @brief Destruye el objeto referenciado por el handle.
+		 *
+		 * Los handles existentes al objeto quedan obsoletos.
+		 *
+		 * @param handle Handle al objeto.
+		 * @return true si el handle era vlido y el objeto se destruy.
+		 */
+		bool destroy(Handle handle)
+		{
+			if (!isValid(handle))
+			{
+				return false;
+			}
+			release(handle.index);
+			return true;
+		}
+
+		/**
+		 * @brief Obtener el objeto referenciado por el handle.
+		 *
+		 * @param handle Handle al objeto.
+		 * @return Puntero al objeto, o nullptr si el handle es obsoleto o nulo.
+		 */
+		T* get(Handle handle)
+		{
+			return isValid(handle) ? slot(handle.index) : nullptr;
+		}
+
+		/**
+		 * @brief Obtener el objeto referenciado por el handle (versin constante).
+		 */
+		const T* get(Handle handle) const
+		{
+			return isValid(handle) ? slot(handle.index) : nullptr;
+		}
+
+		/**
+		 * @brief Comprobar si el handle apunta a un objeto vivo.
+		 *
+		 * @param handle Handle a comprobar.
+		 * @return true si el objeto existe y el handle no es obsoleto.
+		 */
+		bool isValid(Handle handle) const
+		{
+			return handle.index < m_generations.size()
+				&& m_generations[handle.index] == handle.generation
+				&& m_alive[handle.index];
+		}
+
+		/**
+		 * @brief Recorre todos los objetos vivos en orden de ndice.
+		 *
+		 * @param function Llamable con firma void(Handle, T&).
+		 */
+		template<typename Function>
+		void forEach(Function&& function)
+		{
+			const std::uint32_t count = static_cast<std::uint32_t>(m_generations.size());
+			for (std::uint32_t index = 0; index < count; ++index)
+			{
+				if (m_alive[index])
+				{
+					function(Handle{ index, m_generations[index] }, *slot(index));
+				}
+			}
+		}
+
+		/**
+		 * @brief Destruye todos los objetos vivos.
+		 */
+		void clear()
+		{
+			const std::uint32_t count = static_cast<std::uint32_t>(m_generations.size());
+			for (std::uint32_t index = 0; index < count; ++index)
+			{
+				if (m_alive[index])
+				{
+					release(index);
+				}
+			}
+		}
+
+		/**
+		 * @brief Reserva memoria para al menos capacity espacios.
+		 *
+		 * Crea de una vez las pginas y el espacio de los arreglos de control, para que
+		 * crear muchos objetos seguidos no reserve memoria en cada pgina.
+		 *
+		 * @param capacity Nmero total de espacios deseado.
+		 */
+		void reserve(std::size_t capacity)
+		{
+			m_generations.reserve(capacity);
+			m_alive.reserve(capacity);
+			while (m_pages.size() * PageSize < capacity)
+			{
+				m_pages.push_back(std::unique_ptr<Page>(new Page));
+			}
+		}
+
+		/**
+		 * @brief Obtener el nmero de objetos vivos.
+		 */
+		std::size_t size() const { return m_size; }
+
+		/**
+		 * @brief Obtener el nmero de espacios creados (vivos o libres).
+		 */
+		std::size_t slotCount() const { return m_generations.size(); }
+
+	private:
+		/**
+		 * @brief Pgina de espacios contiguos; nunca se mueve una vez creada.
+		 */
+		struct Page
+		{
+			alignas(T) unsigned char storage[sizeof(T) * PageSize]; ///< Memoria de los objetos.
+		};
+
+		/**
+		 * @brief Obtener la direccin del espacio index.
+		 */
+		T* slot(std::uint32_t index) const
+		{
+			unsigned char* page = m_pages[index / PageSize]->storage;
+			return std::launder(reinterpret_cast<T*>(page + sizeof(T) * (index % PageSize)));
+		}
+
+		/**
+		 * @brief Destruye el objeto del espacio index y lo marca como libre.
+		 */
+		void release(std::uint32_t index)
+		{
+			slot(index)->~T();
+			MEMORY_TRACK_FREE(T, sizeof(T));
+			m_alive[index] = 0;
+			// La generacin 0 est reservada para handles nulos.
+			if (++m_generations[index] == 0)
+			{
+				m_generations[index] = 1;
+			}
+			m_freeIndices.push_back(index);
+			--m_size;
+		}
+
+		std::vector<std::unique_ptr<Page>> m_pages; ///< Pginas con los objetos.
+		std::vector<std::uint32_t> m_generations;   ///< Generacin actual de cada espacio.
+		std::vector<std::uint8_t> m_alive;          ///< Indica si cada espacio tiene un objeto.
+		std::vector<std::uint32_t> m_freeIndices;   ///< Espacios libres para reutilizar.
+		std::size_t m_size = 0;                     ///< Nmero de objetos vivos.
+	};
+}
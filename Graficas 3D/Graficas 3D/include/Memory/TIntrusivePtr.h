@@ -0,0 +1,339 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <type_traits>
+#include <utility>
+#include "MemoryTracker.h"
+#include "RefCountPolicy.h"
+#include "TPoolAllocator.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Clase base que guarda el recuento de referencias dentro del propio objeto.
+	 *
+	 * Los objetos que heredan de TRefCounted se gestionan con TIntrusivePtr: el
+	 * contador vive en el objeto, as que no se necesita una asignacin aparte para
+	 * el bloque de control y el puntero es del tamao de un puntero crudo.
+	 *
+	 * Un objeto TRefCounted no debe gestionarse a la vez con TSharedPointer y con
+	 * TIntrusivePtr, ya que cada uno intentara liberarlo por su cuenta.
+	 *
+	 * @tparam RefCountPolicy Poltica del recuento de referencias.
+	 */
+	template<typename RefCountPolicy = ThreadSafePolicy>
+	class TRefCounted
+	{
+	public:
+		/**
+		 * @brief Agrega una referencia al objeto.
+		 */
+		void addRef() const { RefCountPolicy::increment(m_refCount); }
+
+		/**
+		 * @brief Suelta una referencia al objeto y lo destruye si era la ltima.
+		 */
+		void releaseRef() const
+		{
+			if (RefCountPolicy::decrement(m_refCount))
+			{
+#ifdef GALVAN_MEMORY_TRACKING
+				if (m_trackedStats)
+				{
+					m_trackedStats->onFree(m_trackedBytes);
+				}
+#endif
+				delete this;
+			}
+		}
+
+		/**
+		 * @brief Obtener el nmero de referencias al objeto.
+		 *
+		 * @return Recuento de referencias actual.
+		 */
+		int refCount() const { return RefCountPolicy::load(m_refCount); }
+
+		/**
+		 * @brief Registra en la telemetra que el objeto se cre como un T.
+		 *
+		 * Lo llama MakeIntrusive. Se guardan los contadores de T porque releaseRef()
+		 * solo conoce la clase base; los objetos creados de otra forma no se registran.
+		 *
+		 * @tparam T Tipo con el que se cre el objeto.
+		 */
+		template<typename T>
+		void trackAllocation() const
+		{
+			MEMORY_TRACK_ALLOC(T, sizeof(T));
+#ifdef GALVAN_MEMORY_TRACKING
+			m_trackedStats = &MemoryTracker::statsFor<T>();
+			m_trackedBytes = sizeof(T);
+#endif
+		}
+
+	protected:
+		TRefCounted() : m_refCount(0) {}
+
+		// Copiar un objeto no copia sus referencias: la copia empieza sin dueos.
+		TRefCounted(const TRefCounted&) : m_refCount(0) {}
+		TRefCounted& operator=(const TRefCounted&) { return *this; }
+
+		virtual ~TRefCounted() = default;
+
+	private:
+		mutable typename RefCountPolicy::CounterType m_refCount; ///< Recuento de referencias intrusivo.
+#ifdef GALVAN_MEMORY_TRACKING
+		mutable MemoryTypeStats* m_trackedStats = nullptr; ///< Contadores del tipo creado, o nullptr.
+		mutable std::size_t m_trackedBytes = 0;            ///< Bytes registrados al crearlo.
+#endif
+	};
+
+	/**
+	 * @brief Clase TIntrusivePtr para objetos con recuento de referencias propio.
+	 *
+	 * Funciona como TSharedPointer, pero el recuento vive en el objeto apuntado
+	 * (ver TRefCounted). T debe proveer addRef() y releaseRef().
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 */
+	template<typename T>
+	class TIntrusivePtr
+	{
+	public:
+		/**
+		 * @brief Constructor por defecto.
+		 *
+		 * Inicializa el puntero a nullptr.
+		 */
+		TIntrusivePtr() : ptr(nullptr) {}
+
+		/**
+		 * @brief Constructor que toma un puntero crudo.
+		 *
+		 * Agrega una referencia al objeto.
+		 *
+		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
+		 */
+		explicit TIntrusivePtr(T* rawPtr) : ptr(rawPtr)
+		{
+			if (ptr)
+			{
+				ptr->addRef();
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia.
+		 *
+		 * @param other Otro TIntrusivePtr del mismo tipo T.
+		 */
+		TIntrusivePtr(const TIntrusivePtr& other) : ptr(other.ptr)
+		{
+			if (ptr)
+			{
+				ptr->addRef();
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia desde un tipo derivado.
+		 *
+		 * La conversin es esttica, sin dynamic_cast.
+		 *
+		 * @param other TIntrusivePtr a un tipo U convertible a T.
+		 */
+		template<typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+		TIntrusivePtr(const TIntrusivePtr<U>& other) : ptr(other.get())
+		{
+			if (ptr)
+			{
+				ptr->addRef();
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento.
+		 *
+		 * @param other Otro TIntrusivePtr del mismo tipo T.
+		 */
+		TIntrusivePtr(TIntrusivePtr&& other) noexcept : ptr(other.ptr)
+		{
+			other.ptr = nullptr;
+		}
+
+		/**
+		 * @brief Constructor de movimiento desde un tipo derivado.
+		 *
+		 * @param other TIntrusivePtr a un tipo U convertible a T.
+		 */
+		template<typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+		TIntrusivePtr(TIntrusivePtr<U>&& other) noexcept : ptr(other.detach()) {}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 *
+		 * @param other Otro TIntrusivePtr del mismo tipo T.
+		 * @return Referencia al TIntrusivePtr actual.
+		 */
+		TIntrusivePtr& operator=(const TIntrusivePtr& other)
+		{
+			TIntrusivePtr(other).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 *
+		 * @param other Otro TIntrusivePtr del mismo tipo T.
+		 * @return Referencia al TIntrusivePtr actual.
+		 */
+		TIntrusivePtr& operator=(TIntrusivePtr&& other) noexcept
+		{
+			TIntrusivePtr(std::move(other)).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor.
+		 *
+		 * Suelta la referencia; el objeto se destruye si era la ltima.
+		 */
+		~TIntrusivePtr()
+		{
+			if (ptr)
+			{
+				ptr->releaseRef();
+			}
+		}
+
+		/**
+		 * @brief Operador de desreferenciacin.
+		 *
+		 * @return Referencia al objeto gestionado.
+		 */
+		T& operator*() const { return *ptr; }
+
+		/**
+		 * @brief Operador de acceso a miembros.
+		 *
+		 * @return Puntero al objeto gestionado.
+		 */
+		T* operator->() const { return ptr; }
+
+		// Comprobar si el puntero es vlido
+		operator bool() const {
+			return ptr != nullptr;
+		}
+
+		/**
+		 * @brief Obtener el puntero crudo.
+		 *
+		 * @return Puntero crudo al objeto gestionado.
+		 */
+		T* get() const { return ptr; }
+
+		/**
+		 * @brief Comprobar si el puntero es nulo.
+		 *
+		 * @return true si el puntero es nulo, false en caso contrario.
+		 */
+		bool isNull() const { return ptr == nullptr; }
+
+		/**
+		 * @brief Mtodo swap.
+		 *
+		 * @param other Otro TIntrusivePtr del mismo tipo T.
+		 */
+		void swap(TIntrusivePtr& other) noexcept
+		{
+			T* tempPtr = other.ptr;
+			other.ptr = ptr;
+			ptr = tempPtr;
+		}
+
+		/**
+		 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
+		 *
+		 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar.
+		 */
+		void reset(T* newPtr = nullptr)
+		{
+			TIntrusivePtr(newPtr).swap(*this);
+		}
+
+		/**
+		 * @brief Entrega el puntero crudo sin soltar su referencia.
+		 *
+		 * @return Puntero crudo; quien lo recibe es dueo de la referencia.
+		 */
+		T* detach()
+		{
+			T* oldPtr = ptr;
+			ptr = nullptr;
+			return oldPtr;
+		}
+
+		// Mtodo de conversin para hacer cast dinmico
+		template<typename U>
+		TIntrusivePtr<U> dynamic_pointer_cast() const {
+			return TIntrusivePtr<U>(dynamic_cast<U*>(ptr));
+		}
+
+		// Mtodo de conversin para hacer cast esttico (el llamador garantiza el tipo)
+		template<typename U>
+		TIntrusivePtr<U> static_pointer_cast() const {
+			return TIntrusivePtr<U>(static_cast<U*>(ptr));
+		}
+
+	private:
+		T* ptr; ///< Puntero al objeto gestionado.
+	};
+
+	/**
+	 * @brief Funcin de utilidad para crear un TIntrusivePtr.
+	 *
+	 * Registra el objeto en la telemetra, salvo que T herede de TPooledObject<T>:
+	 * entonces su TPoolAllocator ya registra el bloque al reservarlo y al devolverlo.
+	 *
+	 * @tparam T Tipo del objeto gestionado, derivado de TRefCounted.
+	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
+	 * @param args Argumentos reenviados al constructor del objeto gestionado.
+	 * @return Un objeto TIntrusivePtr gestionando un nuevo objeto de tipo T.
+	 */
+	template<typename T, typename... Args>
+	TIntrusivePtr<T> MakeIntrusive(Args&&... args)
+	{
+		T* object = new T(std::forward<Args>(args)...);
+		if constexpr (!std::is_base_of<TPooledObject<T>, T>::value)
+		{
+			object->template trackAllocation<T>();
+		}
+		return TIntrusivePtr<T>(object);
+	}
+}
@@ -0,0 +1,249 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "MemoryTracker.h"
+#include "SpinLock.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Asignador de bloques de tamao fijo para un tipo concreto.
+	 *
+	 * Reserva la memoria por trozos de BlocksPerChunk bloques contiguos y reutiliza
+	 * los bloques liberados mediante una lista libre. Asignar y liberar cuesta unas
+	 * pocas instrucciones en lugar de una llamada a malloc, y los objetos del mismo
+	 * tipo quedan juntos en memoria.
+	 *
+	 * Cada tipo tiene un pool global accesible con instance(). Las operaciones estn
+	 * protegidas por un SpinLock, as que un objeto puede liberarse desde un hilo
+	 * distinto al que lo cre. Los trozos no se devuelven al sistema hasta que el pool
+	 * se destruye al terminar el programa.
+	 *
+	 * @tparam T Tipo de los objetos que se guardan en el pool.
+	 * @tparam BlocksPerChunk Nmero de bloques que se reservan cada vez que el pool crece.
+	 */
+	template<typename T, std::size_t BlocksPerChunk = 64>
+	class TPoolAllocator
+	{
+	public:
+		TPoolAllocator() = default;
+		TPoolAllocator(const TPoolAllocator&) = delete;
+		TPoolAllocator& operator=(const TPoolAllocator&) = delete;
+
+		/**
+		 * @brief Destructor.
+		 *
+		 * Devuelve todos los trozos al sistema. Los objetos que sigan vivos no se destruyen.
+		 */
+		~TPoolAllocator()
+		{
+			for (Block* chunk : m_chunks)
+			{
+				::operator delete(chunk, std::align_val_t(alignof(Block)));
+			}
+		}
+
+		/**
+		 * @brief Obtener el pool global de T.
+		 *
+		 * @return Referencia al pool compartido por todo el programa.
+		 */
+		static TPoolAllocator& instance()
+		{
+			static TPoolAllocator pool;
+			return pool;
+		}
+
+		/**
+		 * @brief Reserva un bloque sin construir el objeto.
+		 *
+		 * @return Puntero a memoria sin inicializar con tamao y alineacin de T.
+		 */
+		void* allocate()
+		{
+			std::lock_guard<SpinLock> guard(m_lock);
+			if (m_freeList == nullptr)
+			{
+				grow();
+			}
+			Block* block = m_freeList;
+			m_freeList = block->next;
+			++m_liveCount;
+			MEMORY_TRACK_ALLOC(T, sizeof(Block));
+			return block->storage;
+		}
+
+		/**
+		 * @brief Devuelve un bloque al pool sin destruir el objeto.
+		 *
+		 * @param memory Bloque obtenido con allocate().
+		 */
+		void deallocate(void* memory)
+		{
+			if (memory == nullptr)
+			{
+				return;
+			}
+			Block* block = static_cast<Block*>(memory);
+			std::lock_guard<SpinLock> guard(m_lock);
+			block->next = m_freeList;
+			m_freeList = block;
+			--m_liveCount;
+			MEMORY_TRACK_FREE(T, sizeof(Block));
+		}
+
+		/**
+		 * @brief Reserva un bloque y construye un objeto en l.
+		 *
+		 * @param args Argumentos reenviados al constructor de T.
+		 * @return Puntero al objeto construido.
+		 */
+		template<typename... Args>
+		T* construct(Args&&... args)
+		{
+			void* memory = allocate();
+			try
+			{
+				return ::new (memory) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				deallocate(memory);
+				throw;
+			}
+		}
+
+		/**
+		 * @brief Destruye un objeto y devuelve su bloque al pool.
+		 *
+		 * @param object Objeto creado con construct().
+		 */
+		void destroy(T* object)
+		{
+			if (object != nullptr)
+			{
+				object->~T();
+				deallocate(object);
+			}
+		}
+
+		/**
+		 * @brief Obtener el nmero de bloques en uso.
+		 */
+		std::size_t liveCount() const { return m_liveCount; }
+
+		/**
+		 * @brief Obtener el nmero total de bloques reservados.
+		 */
+		std::size_t capacity() const { return m_chunks.size() * BlocksPerChunk; }
+
+	private:
+		/**
+		 * @brief Bloque del pool: guarda un objeto o, si est libre, el siguiente bloque libre.
+		 */
+		union Block
+		{
+			Block* next; ///< Siguiente bloque libre.
+			alignas(T) unsigned char storage[sizeof(T)]; ///< Memoria del objeto.
+		};
+
+		/**
+		 * @brief Reserva un trozo nuevo y encadena sus bloques en la lista libre.
+		 */
+		void grow()
+		{
+			Block* chunk = static_cast<Block*>(
+				::operator new(sizeof(Block) * BlocksPerChunk, std::align_val_t(alignof(Block))));
+			m_chunks.push_back(chunk);
+			// Encadenar en orden para que las asignaciones consecutivas sean contiguas.
+			for (std::size_t i = 0; i < BlocksPerChunk - 1; ++i)
+			{
+				chunk[i].next = &chunk[i + 1];
+			}
+			chunk[BlocksPerChunk - 1].next = m_freeList;
+			m_freeList = chunk;
+		}
+
+		SpinLock m_lock;                ///< Protege la lista libre.
+		Block* m_freeList = nullptr;    ///< Primer bloque libre.
+		std::vector<Block*> m_chunks;   ///< Trozos reservados.
+		std::size_t m_liveCount = 0;    ///< Bloques entregados y no devueltos.
+	};
+
+	/**
+	 * @brief Clase base que hace que new y delete de T usen su TPoolAllocator.
+	 *
+	 * Al heredar de TPooledObject<T>, cualquier new T (incluido MakeIntrusive<T>) toma
+	 * un bloque del pool de T. Las clases derivadas de T con otro tamao siguen
+	 * usando el asignador global.
+	 *
+	 * @tparam T Tipo que hereda de esta clase.
+	 */
+	template<typename T>
+	class TPooledObject
+	{
+	public:
+		static void* operator new(std::size_t size)
+		{
+			if (size != sizeof(T))
+			{
+				return ::operator new(size);
+			}
+			return TPoolAllocator<T>::instance().allocate();
+		}
+
+		static void operator delete(void* memory, std::size_t size)
+		{
+			if (size != sizeof(T))
+			{
+				::operator delete(memory);
+				return;
+			}
+			TPoolAllocator<T>::instance().deallocate(memory);
+		}
+	};
+
+	/**
+	 * @brief Borrador para TUniquePtr que devuelve el objeto a su TPoolAllocator.
+	 *
+	 * @tparam T Tipo del objeto, creado con TPoolAllocator<T>::construct.
+	 */
+	template<typename T>
+	struct TPoolDelete
+	{
+		void operator()(T* object) const
+		{
+			TPoolAllocator<T>::instance().destroy(object);
+		}
+	};
+}
@@ -27,6 +27,8 @@
  * SOFTWARE.
 */
 #pragma once
+#include <utility>
+#include "TControlBlock.h"
 
 namespace EngineUtilities {
 	/**
@@ -34,40 +36,62 @@ namespace EngineUtilities {
 	 *
 	 * La clase TSharedPointer gestiona la memoria de un objeto de tipo T y lleva un
 	 * recuento de referencias para permitir la comparticin segura de un mismo objeto
-	 * en mltiples instancias de TSharedPointer.
+	 * en mltiples instancias de TSharedPointer. El recuento vive en un bloque de
+	 * control (ver TControlBlock.h); con MakeShared el objeto vive dentro del mismo bloque.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam RefCountPolicy Poltica del recuento de referencias. Por defecto es
+	 *         ThreadSafePolicy (contador atmico); SingleThreadPolicy es la ruta rpida
+	 *         para objetos que nunca salen del hilo principal.
 	 */
-	template<typename T>
+	template<typename T, typename RefCountPolicy = ThreadSafePolicy>
 	class TSharedPointer
 	{
 	public:
+		using ControlBlock = ControlBlockBase<RefCountPolicy>; ///< Tipo del bloque de control.
+
 		/**
 		 * @brief Constructor por defecto.
 		 *
-		 * Inicializa el puntero y el recuento de referencias a nullptr.
+		 * Inicializa el puntero y el bloque de control a nullptr.
 		 */
-		TSharedPointer() : ptr(nullptr), refCount(nullptr) {}
+		TSharedPointer() : ptr(nullptr), control(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un puntero crudo.
 		 *
 		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
 		 */
-		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(new int(1)) {}
+		explicit TSharedPointer(T* rawPtr)
+			: ptr(rawPtr), control(rawPtr ? new TPointerControlBlock<T, RefCountPolicy>(rawPtr) : nullptr) {}
 
 		/**
-		 * @brief Constructor desde un puntero crudo y un recuento de referencias.
+		 * @brief Constructor desde un puntero crudo y un bloque de control existente.
+		 *
+		 * Agrega una referencia al bloque.
 		 *
 		 * @param rawPtr Puntero crudo al objeto gestionado.
-		 * @param existingRefCount Puntero al recuento de referencias existente.
+		 * @param existingControl Bloque de control existente.
 		 */
-		TSharedPointer(T* rawPtr, int* existingRefCount) : ptr(rawPtr), refCount(existingRefCount)
+		TSharedPointer(T* rawPtr, ControlBlock* existingControl) : ptr(rawPtr), control(existingControl)
 		{
-			if (refCount)
+			if (control)
 			{
-				++(*refCount);
+				control->addStrong();
 			}
 		}
 
+		/**
+		 * @brief Constructor que adopta una referencia ya contada en el bloque.
+		 *
+		 * No incrementa el recuento; lo usan las funciones de creacin como MakeShared.
+		 *
+		 * @param rawPtr Puntero crudo al objeto gestionado.
+		 * @param existingControl Bloque de control cuya referencia se adopta.
+		 */
+		TSharedPointer(T* rawPtr, ControlBlock* existingControl, AdoptReference)
+			: ptr(rawPtr), control(existingControl) {}
+
 		/**
 		 * @brief Constructor de copia.
 		 *
@@ -76,11 +100,11 @@ namespace EngineUtilities {
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(const TSharedPointer<T>& other) : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(const TSharedPointer& other) : ptr(other.ptr), control(other.control)
 		{
-			if (refCount)
+			if (control)
 			{
-				++(*refCount);
+				control->addStrong();
 			}
 		}
 
@@ -92,10 +116,10 @@ namespace EngineUtilities {
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(TSharedPointer<T>&& other) noexcept : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(TSharedPointer&& other) noexcept : ptr(other.ptr), control(other.control)
 		{
 			other.ptr = nullptr;
-			other.refCount = nullptr;
+			other.control = nullptr;
 		}
 
 		/**
@@ -107,23 +131,20 @@ namespace EngineUtilities {
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(const TSharedPointer<T>& other)
+		TSharedPointer& operator=(const TSharedPointer& other)
 		{
 			if (this != &other)
 			{
-				// Disminuir el recuento de referencias del objeto actual
-				if (refCount && --(*refCount) == 0)
+				// Aumentar primero el recuento del otro puntero por si ambos comparten objeto
+				if (other.control)
 				{
-					delete ptr;
-					delete refCount;
+					other.control->addStrong();
 				}
+				// Disminuir el recuento de referencias del objeto actual
+				release();
 				// Copiar datos del otro puntero compartido
 				ptr = other.ptr;
-				refCount = other.refCount;
-				if (refCount)
-				{
-					++(*refCount);
-				}
+				control = other.control;
 			}
 			return *this;
 		}
@@ -137,21 +158,17 @@ namespace EngineUtilities {
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(TSharedPointer<T>&& other) noexcept
+		TSharedPointer& operator=(TSharedPointer&& other) noexcept
 		{
 			if (this != &other)
 			{
 				// Liberar el objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
+				release();
 				// Transferir los datos del otro puntero compartido
 				ptr = other.ptr;
-				refCount = other.refCount;
+				control = other.control;
 				other.ptr = nullptr;
-				other.refCount = nullptr;
+				other.control = nullptr;
 			}
 			return *this;
 		}
@@ -164,11 +181,7 @@ namespace EngineUtilities {
 		 */
 		~TSharedPointer()
 		{
-			if (refCount && --(*refCount) == 0)
-			{
-				delete ptr;
-				delete refCount;
-			}
+			release();
 		}
 
 		/**
@@ -204,10 +217,17 @@ namespace EngineUtilities {
 		 */
 		bool isNull() const { return ptr == nullptr; }
 
+		/**
+		 * @brief Obtener el nmero de TSharedPointer que comparten el objeto.
+		 *
+		 * @return Recuento de referencias actual, o 0 si el puntero es nulo.
+		 */
+		int useCount() const { return control ? control->useCount() : 0; }
+
 
 	public:
 		T* ptr;       ///< Puntero al objeto gestionado.
-		int* refCount; ///< Puntero al recuento de referencias.
+		ControlBlock* control; ///< Puntero al bloque de control con el recuento de referencias.
 
 		/**
 		 * @brief Mtodo swap.
@@ -216,16 +236,16 @@ namespace EngineUtilities {
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		void swap(TSharedPointer<T>& other) noexcept
+		void swap(TSharedPointer& other) noexcept
 		{
 			T* tempPtr = other.ptr;
-			int* tempRefCount = other.refCount;
+			ControlBlock* tempControl = other.control;
 
 			other.ptr = this->ptr;
-			other.refCount = this->refCount;
+			other.control = this->control;
 
 			this->ptr = tempPtr;
-			this->refCount = tempRefCount;
+			this->control = tempControl;
 		}
 
 		/**
@@ -236,53 +256,126 @@ namespace EngineUtilities {
 		void reset(T* newPtr = nullptr)
 		{
 			// Disminuir el recuento de referencias del objeto actual
-			if (refCount && --(*refCount) == 0)
-			{
-				delete ptr;
-				delete refCount;
-			}
+			release();
 
-			// Si newPtr es nullptr, asignar nullptr al puntero y recuento de referencias
+			// Si newPtr es nullptr, asignar nullptr al puntero y bloque de control
 			if (newPtr == nullptr)
 			{
 				ptr = nullptr;
-				refCount = nullptr;
+				control = nullptr;
 			}
 			else
 			{
-				// Asignar nuevo objeto y manejar el recuento de referencias
+				// Asignar nuevo objeto y crear su bloque de control
 				ptr = newPtr;
-				refCount = new int(1);
+				control = new TPointerControlBlock<T, RefCountPolicy>(newPtr);
 			}
 		}
 
 		// Mtodo de conversin para hacer cast dinmico
 		template<typename U>
-		TSharedPointer<U> dynamic_pointer_cast() const {
+		TSharedPointer<U, RefCountPolicy> dynamic_pointer_cast() const {
 			// Intenta convertir el puntero de tipo T a U
 			U* castedPtr = dynamic_cast<U*>(ptr);
 			if (castedPtr) {
 				// Si la conversin es exitosa, devuelve un nuevo TSharedPointer<U>
-				return TSharedPointer<U>(castedPtr, refCount);
+				return TSharedPointer<U, RefCountPolicy>(castedPtr, control);
 			}
 			else {
 				// Si falla la conversin, devuelve un TSharedPointer<U> nulo
-				return TSharedPointer<U>();
+				return TSharedPointer<U, RefCountPolicy>();
+			}
+		}
+
+	private:
+		/**
+		 * @brief Suelta la referencia actual.
+		 *
+		 * Disminuye el recuento de referencias y, si era la ltima, el bloque de
+		 * control destruye el objeto gestionado. No modifica ptr ni control.
+		 */
+		void release()
+		{
+			if (control)
+			{
+				control->releaseStrong();
 			}
 		}
 	};
 
+	/**
+	 * @brief Alias de TSharedPointer con recuento no atmico.
+	 *
+	 * Para objetos que solo se comparten dentro del hilo principal.
+	 */
+	template<typename T>
+	using TLocalSharedPointer = TSharedPointer<T, SingleThreadPolicy>;
+
+	/**
+	 * @brief Crea un objeto y su bloque de control en una sola asignacin.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam RefCountPolicy Poltica del recuento de referencias.
+	 * @param args Argumentos reenviados al constructor del objeto gestionado.
+	 * @return Un TSharedPointer gestionando un nuevo objeto de tipo T.
+	 */
+	template<typename T, typename RefCountPolicy, typename... Args>
+	TSharedPointer<T, RefCountPolicy> MakeSharedWithPolicy(Args&&... args)
+	{
+		using Block = TInplaceControlBlock<T, RefCountPolicy>;
+		Block* block = new Block(std::forward<Args>(args)...);
+		MEMORY_TRACK_ALLOC(Block, sizeof(Block));
+		return TSharedPointer<T, RefCountPolicy>(block->get(), block, AdoptReference{});
+	}
+
 	/**
 	 * @brief Funcin de utilidad para crear un TSharedPointer.
 	 *
+	 * El objeto y su recuento de referencias se reservan juntos en un nico bloque,
+	 * y los argumentos se reenvan sin copias al constructor de T.
+	 *
 	 * @tparam T Tipo del objeto gestionado.
 	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
 	 * @param args Argumentos del constructor del objeto gestionado.
 	 * @return Un objeto TSharedPointer gestionando un nuevo objeto de tipo T.
 	 */
 	template<typename T, typename... Args>
-	TSharedPointer<T> MakeShared(Args... args)
+	TSharedPointer<T> MakeShared(Args&&... args)
+	{
+		return MakeSharedWithPolicy<T, ThreadSafePolicy>(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Funcin de utilidad para crear un TLocalSharedPointer.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
+	 * @param args Argumentos del constructor del objeto gestionado.
+	 * @return Un objeto TLocalSharedPointer gestionando un nuevo objeto de tipo T.
+	 */
+	template<typename T, typename... Args>
+	TLocalSharedPointer<T> MakeLocalShared(Args&&... args)
+	{
+		return MakeSharedWithPolicy<T, SingleThreadPolicy>(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Crea un TSharedPointer cuyo objeto y bloque de control viven en un pool.
+	 *
+	 * Como MakeShared, pero el bloque sale del TPoolAllocator de TPooledControlBlock<T>
+	 * en lugar del asignador global: crear y destruir muchos objetos del mismo tipo
+	 * no pasa por malloc y los objetos quedan contiguos en memoria.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
+	 * @param args Argumentos reenviados al constructor del objeto gestionado.
+	 * @return Un TSharedPointer gestionando un nuevo objeto de tipo T.
+	 */
+	template<typename T, typename... Args>
+	TSharedPointer<T> AllocateShared(Args&&... args)
 	{
-		return TSharedPointer<T>(new T(args...));
+		using Block = TPooledControlBlock<T, ThreadSafePolicy>;
+		Block* block = Block::Pool::instance().construct(std::forward<Args>(args)...);
+		return TSharedPointer<T>(block->get(), block, AdoptReference{});
 	}
 }
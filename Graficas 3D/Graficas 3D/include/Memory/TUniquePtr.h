@@ -27,16 +27,35 @@
  * SOFTWARE.
 */
 #pragma once
+#include <type_traits>
+#include <utility>
+#include "MemoryTracker.h"
+#include "TPoolAllocator.h"
 
 namespace EngineUtilities {
+  /**
+   * @brief Borrador por defecto de TUniquePtr: libera el objeto con delete.
+   *
+   * @tparam T Tipo del objeto gestionado.
+   */
+  template<typename T>
+  struct DefaultDelete
+  {
+    void operator()(T* object) const { delete object; }
+  };
+
   /**
  * @brief Clase TUniquePtr para manejo exclusivo de memoria.
  *
  * La clase TUniquePtr gestiona la memoria de un objeto de tipo T y garantiza
  * que solo una instancia de TUniquePtr puede poseer y gestionar el objeto en
  * cualquier momento.
+ *
+ * @tparam T Tipo del objeto gestionado.
+ * @tparam Deleter Borrador sin estado que libera el objeto (por defecto usa delete;
+ *         TPoolDelete lo devuelve a su TPoolAllocator).
  */
-  template<typename T>
+  template<typename T, typename Deleter = DefaultDelete<T>>
   class TUniquePtr
   {
   public:
@@ -52,7 +71,13 @@ namespace EngineUtilities {
      *
      * @param rawPtr Puntero crudo al objeto que se va a gestionar.
      */
-    explicit TUniquePtr(T* rawPtr) : ptr(rawPtr) {}
+    explicit TUniquePtr(T* rawPtr) : ptr(rawPtr)
+    {
+      if (ptr != nullptr)
+      {
+        trackAllocation();
+      }
+    }
 
     /**
      * @brief Constructor de movimiento.
@@ -61,7 +86,7 @@ namespace EngineUtilities {
      *
      * @param other Otro objeto TUniquePtr del mismo tipo T.
      */
-    TUniquePtr(TUniquePtr<T>&& other) noexcept : ptr(other.ptr)
+    TUniquePtr(TUniquePtr&& other) noexcept : ptr(other.ptr)
     {
       other.ptr = nullptr;
     }
@@ -75,12 +100,12 @@ namespace EngineUtilities {
      * @param other Otro objeto TUniquePtr del mismo tipo T.
      * @return Referencia al objeto TUniquePtr actual.
      */
-    TUniquePtr<T>& operator=(TUniquePtr<T>&& other) noexcept
+    TUniquePtr& operator=(TUniquePtr&& other) noexcept
     {
       if (this != &other)
       {
         // Liberar el objeto actual
-        delete ptr;
+        destroy();
 
         // Transferir los datos del otro puntero exclusivo
         ptr = other.ptr;
@@ -96,12 +121,12 @@ namespace EngineUtilities {
      */
     ~TUniquePtr()
     {
-      delete ptr;
+      destroy();
     }
 
     // Prohibir la copia de TUniquePtr
-    TUniquePtr(const TUniquePtr<T>&) = delete;
-    TUniquePtr<T>& operator=(const TUniquePtr<T>&) = delete;
+    TUniquePtr(const TUniquePtr&) = delete;
+    TUniquePtr& operator=(const TUniquePtr&) = delete;
 
     /**
      * @brief Operador de desreferenciacin.
@@ -133,6 +158,10 @@ namespace EngineUtilities {
      */
     T* release()
     {
+      if (ptr != nullptr)
+      {
+        trackFree();
+      }
       T* oldPtr = ptr;
       ptr = nullptr;
       return oldPtr;
@@ -147,8 +176,12 @@ namespace EngineUtilities {
      */
     void reset(T* rawPtr = nullptr)
     {
-      delete ptr;
+      destroy();
       ptr = rawPtr;
+      if (ptr != nullptr)
+      {
+        trackAllocation();
+      }
     }
 
     /**
@@ -161,6 +194,42 @@ namespace EngineUtilities {
       return ptr == nullptr;
     }
   private:
+    /**
+     * @brief Libera el objeto gestionado con el borrador, si existe.
+     */
+    void destroy()
+    {
+      if (ptr != nullptr)
+      {
+        trackFree();
+        Deleter()(ptr);
+      }
+    }
+
+    /**
+     * @brief Registra en la telemetra que se tom la propiedad de un objeto.
+     *
+     * Solo aplica al borrador por defecto; los pools registran su propia memoria.
+     */
+    void trackAllocation()
+    {
+      if constexpr (std::is_same<Deleter, DefaultDelete<T>>::value)
+      {
+        MEMORY_TRACK_ALLOC(T, sizeof(T));
+      }
+    }
+
+    /**
+     * @brief Registra en la telemetra que se liber o cedi un objeto.
+     */
+    void trackFree()
+    {
+      if constexpr (std::is_same<Deleter, DefaultDelete<T>>::value)
+      {
+        MEMORY_TRACK_FREE(T, sizeof(T));
+      }
+    }
+
     T* ptr; ///< Puntero al objeto gestionado.
   };
 
@@ -173,9 +242,23 @@ namespace EngineUtilities {
    * @return Un objeto TUniquePtr gestionando un nuevo objeto de tipo T.
    */
   template<typename T, typename... Args>
-  TUniquePtr<T> MakeUnique(Args... args)
+  TUniquePtr<T> MakeUnique(Args&&... args)
+  {
+    return TUniquePtr<T>(new T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Crea un TUniquePtr cuyo objeto vive en el TPoolAllocator de T.
+   *
+   * @tparam T Tipo del objeto gestionado.
+   * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
+   * @param args Argumentos reenviados al constructor del objeto gestionado.
+   * @return Un TUniquePtr que devuelve el objeto al pool al destruirse.
+   */
+  template<typename T, typename... Args>
+  TUniquePtr<T, TPoolDelete<T>> AllocateUnique(Args&&... args)
   {
-    return TUniquePtr<T>(new T(args...));
+    return TUniquePtr<T, TPoolDelete<T>>(TPoolAllocator<T>::instance().construct(std::forward<Args>(args)...));
   }
 
   /*
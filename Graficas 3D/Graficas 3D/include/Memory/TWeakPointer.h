@@ -36,45 +36,177 @@ namespace EngineUtilities {
 		 * La clase TWeakPointer proporciona una manera de observar un objeto gestionado por un TSharedPointer
 		 * sin tener influencia sobre el recuento de referencias del objeto. Permite acceder al objeto solo si
 		 * an existe.
+		 *
+		 * El TWeakPointer mantiene vivo el bloque de control (no el objeto), por lo que expired() y lock()
+		 * son seguros aunque el ltimo TSharedPointer ya se haya destruido, incluso desde otro hilo.
 		 */
-	template<typename T>
+	template<typename T, typename RefCountPolicy = ThreadSafePolicy>
 	class TWeakPointer
 	{
 	public:
+		using ControlBlock = ControlBlockBase<RefCountPolicy>; ///< Tipo del bloque de control.
+
 		/**
 		 * @brief Constructor por defecto.
 		 */
-		TWeakPointer() : ptr(nullptr), refCount(nullptr) {}
+		TWeakPointer() : ptr(nullptr), control(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un TSharedPointer.
 		 *
 		 * @param sharedPtr TSharedPointer desde el cual se observar el objeto.
 		 */
-		TWeakPointer(const TSharedPointer<T>& sharedPtr) 
-		: ptr(sharedPtr.ptr), refCount(sharedPtr.refCount) {}
+		TWeakPointer(const TSharedPointer<T, RefCountPolicy>& sharedPtr) 
+		: ptr(sharedPtr.ptr), control(sharedPtr.control)
+		{
+			if (control)
+			{
+				control->addWeak();
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia.
+		 *
+		 * @param other Otro TWeakPointer del mismo tipo T.
+		 */
+		TWeakPointer(const TWeakPointer& other) : ptr(other.ptr), control(other.control)
+		{
+			if (control)
+			{
+				control->addWeak();
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento.
+		 *
+		 * @param other Otro TWeakPointer del mismo tipo T.
+		 */
+		TWeakPointer(TWeakPointer&& other) noexcept : ptr(other.ptr), control(other.control)
+		{
+			other.ptr = nullptr;
+			other.control = nullptr;
+		}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 *
+		 * @param other Otro TWeakPointer del mismo tipo T.
+		 * @return Referencia al TWeakPointer actual.
+		 */
+		TWeakPointer& operator=(const TWeakPointer& other)
+		{
+			if (this != &other)
+			{
+				if (other.control)
+				{
+					other.control->addWeak();
+				}
+				release();
+				ptr = other.ptr;
+				control = other.control;
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 *
+		 * @param other Otro TWeakPointer del mismo tipo T.
+		 * @return Referencia al TWeakPointer actual.
+		 */
+		TWeakPointer& operator=(TWeakPointer&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+				ptr = other.ptr;
+				control = other.control;
+				other.ptr = nullptr;
+				other.control = nullptr;
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Asigna un nuevo objeto observado desde un TSharedPointer.
+		 *
+		 * @param sharedPtr TSharedPointer desde el cual se observar el objeto.
+		 * @return Referencia al TWeakPointer actual.
+		 */
+		TWeakPointer& operator=(const TSharedPointer<T, RefCountPolicy>& sharedPtr)
+		{
+			return *this = TWeakPointer(sharedPtr);
+		}
+
+		/**
+		 * @brief Destructor.
+		 *
+		 * Suelta la referencia dbil; libera el bloque de control si era la ltima.
+		 */
+		~TWeakPointer()
+		{
+			release();
+		}
+
+		/**
+		 * @brief Comprobar si el objeto observado ya fue destruido.
+		 *
+		 * Es una sola lectura del contador, sin crear un TSharedPointer.
+		 *
+		 * @return true si no hay objeto observado o ya fue destruido.
+		 */
+		bool expired() const
+		{
+			return control == nullptr || control->useCount() == 0;
+		}
 
 		/**
 		 * @brief Convertir TWeakPointer a TSharedPointer.
 		 *
+		 * Puede ejecutarse a la vez que otro hilo suelta la ltima referencia fuerte:
+		 * el recuento solo se incrementa si todava no lleg a cero.
+		 *
 		 * @return Un TSharedPointer al objeto gestionado, o nullptr si el objeto ha sido destruido.
 		 */
-		TSharedPointer<T> lock() const
+		TSharedPointer<T, RefCountPolicy> lock() const
 		{
-			if (refCount && *refCount > 0)
+			if (control && control->tryAddStrong())
 			{
-				return TSharedPointer<T>(ptr, refCount);
+				return TSharedPointer<T, RefCountPolicy>(ptr, control, AdoptReference{});
 			}
-			return TSharedPointer<T>();
+			return TSharedPointer<T, RefCountPolicy>();
+		}
+
+		/**
+		 * @brief Deja de observar el objeto.
+		 */
+		void reset()
+		{
+			release();
+			ptr = nullptr;
+			control = nullptr;
 		}
 
 		// Hacer que TSharedPointer sea un amigo para acceder a los miembros privados.
-		template<typename U>
+		template<typename U, typename P>
 		friend class TSharedPointer;
 
 	private:
+		/**
+		 * @brief Suelta la referencia dbil actual sin modificar ptr ni control.
+		 */
+		void release()
+		{
+			if (control)
+			{
+				control->releaseWeak();
+			}
+		}
+
 		T* ptr;       ///< Puntero al objeto observado.
-		int* refCount; ///< Puntero al recuento de referencias del TSharedPointer original.
+		ControlBlock* control; ///< Bloque de control del TSharedPointer original.
 	};
 
 	/*
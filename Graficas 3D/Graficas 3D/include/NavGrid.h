@@ -0,0 +1,76 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+/**
+ * @class NavGrid
+ * @brief Rejilla de navegacin: celdas cuadradas que se pueden recorrer o no.
+ *
+ * Las celdas se numeran por filas (`y * ancho + x`). Es solo datos: la bsqueda de
+ * caminos la hace `Pathfinder` y la coordina `PathService`.
+ */
+class NavGrid {
+public:
+	/**
+	 * @brief Constructor por defecto; una rejilla sin celdas.
+	 */
+	NavGrid() = default;
+
+	/**
+	 * @brief Constructor.
+	 * @param origin Esquina superior izquierda de la rejilla en coordenadas de mundo.
+	 * @param cellSize Lado de cada celda.
+	 * @param width Nmero de columnas.
+	 * @param height Nmero de filas.
+	 *
+	 * Todas las celdas empiezan libres.
+	 */
+	NavGrid(const sf::Vector2f& origin, float cellSize, std::uint32_t width, std::uint32_t height);
+
+	std::uint32_t getWidth() const { return m_width; }
+	std::uint32_t getHeight() const { return m_height; }
+	std::uint32_t getCellCount() const { return m_width * m_height; }
+	float getCellSize() const { return m_cellSize; }
+
+	/**
+	 * @brief ndice de la celda en la columna x y la fila y.
+	 */
+	std::uint32_t toIndex(std::uint32_t x, std::uint32_t y) const { return y * m_width + x; }
+
+	/**
+	 * @brief Indica si una celda se puede recorrer.
+	 */
+	bool isWalkable(std::uint32_t cell) const { return m_walkable[cell] != 0; }
+
+	/**
+	 * @brief Marca una celda como libre u ocupada.
+	 */
+	void setWalkable(std::uint32_t cell, bool walkable) { m_walkable[cell] = walkable ? 1 : 0; }
+
+	/**
+	 * @brief Marca como ocupadas todas las celdas que toca un rectngulo.
+	 * @param rect Rectngulo en coordenadas de mundo.
+	 */
+	void blockRect(const sf::FloatRect& rect);
+
+	/**
+	 * @brief Celda que contiene un punto.
+	 * @param point Punto en coordenadas de mundo; si cae fuera, se usa la celda ms cercana.
+	 */
+	std::uint32_t cellAt(const sf::Vector2f& point) const;
+
+	/**
+	 * @brief Centro de una celda en coordenadas de mundo.
+	 */
+	sf::Vector2f cellCenter(std::uint32_t cell) const {
+		return sf::Vector2f(m_origin.x + (cell % m_width + 0.5f) * m_cellSize,
+			m_origin.y + (cell / m_width + 0.5f) * m_cellSize);
+	}
+
+private:
+	sf::Vector2f m_origin;                  ///< Esquina superior izquierda.
+	float m_cellSize = 1.0f;                ///< Lado de cada celda.
+	std::uint32_t m_width = 0;              ///< Columnas.
+	std::uint32_t m_height = 0;             ///< Filas.
+	std::vector<std::uint8_t> m_walkable;   ///< 1 si la celda se puede recorrer.
+};
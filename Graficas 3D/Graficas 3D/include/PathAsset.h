@@ -0,0 +1,108 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cmath>
+
+/**
+ * @class PathAsset
+ * @brief Recorrido inmutable con su longitud de arco precalculada.
+ *
+ * Guarda, adems de los puntos, el largo de cada tramo y la longitud de arco acumulada
+ * al inicio de cada uno. Con eso la posicin a una distancia recorrida se obtiene con
+ * una bsqueda binaria y una interpolacin, sin races cuadradas por fotograma.
+ *
+ * No cambia despus de construirse, as que muchos agentes pueden compartirlo (con
+ * `PathAssetPtr`) y leerlo desde varios hilos a la vez.
+ */
+class PathAsset {
+public:
+	/**
+	 * @brief Constructor.
+	 * @param points Puntos del recorrido, en orden.
+	 * @param closed Si el ltimo punto se une con el primero y el recorrido se repite.
+	 */
+	PathAsset(std::vector<sf::Vector2f> points, bool closed);
+
+	/**
+	 * @brief Longitud total del recorrido.
+	 */
+	float getLength() const { return m_length; }
+
+	/**
+	 * @brief Indica si el recorrido es cerrado.
+	 */
+	bool isClosed() const { return m_closed; }
+
+	/**
+	 * @brief Nmero de tramos.
+	 */
+	std::size_t getSegmentCount() const { return m_segmentLengths.size(); }
+
+	/**
+	 * @brief Puntos del recorrido; si es cerrado, el primero se repite al final.
+	 */
+	const std::vector<sf::Vector2f>& getPoints() const { return m_points; }
+
+	/**
+	 * @brief Longitud de arco al inicio de cada tramo, ms la longitud total al final.
+	 */
+	const std::vector<float>& getArcLengths() const { return m_arcLengths; }
+
+	/**
+	 * @brief Lleva una distancia al rango del recorrido.
+	 * @param distance Distancia recorrida, que puede salirse del rango.
+	 * @return En un recorrido cerrado, la distancia mdulo la longitud; en uno abierto,
+	 * la distancia recortada a [0, longitud].
+	 */
+	float wrap(float distance) const {
+		if (m_closed) {
+			return m_length > 0.0f ? distance - std::floor(distance * m_invLength) * m_length : 0.0f;
+		}
+		return distance < 0.0f ? 0.0f : (distance > m_length ? m_length : distance);
+	}
+
+	/**
+	 * @brief Posicin a una distancia recorrida.
+	 * @param distance Distancia desde el primer punto; se lleva al rango con `wrap`.
+	 */
+	sf::Vector2f sample(float distance) const;
+
+	/**
+	 * @brief Posiciones de varios agentes a la vez.
+	 * @param distances Distancias, ya dentro del rango del recorrido.
+	 * @param count Nmero de agentes.
+	 * @param positionX Destino de las posiciones X.
+	 * @param positionY Destino de las posiciones Y.
+	 *
+	 * Aprovecha que agentes seguidos suelen estar en el mismo tramo: antes de la
+	 * bsqueda binaria prueba el tramo del agente anterior.
+	 */
+	void sampleBatch(const float* distances, std::size_t count, float* positionX, float* positionY) const;
+
+private:
+	/**
+	 * @brief Tramo que contiene una distancia ya dentro del rango.
+	 */
+	std::size_t findSegment(float distance) const;
+
+	/**
+	 * @brief Posicin dentro de un tramo.
+	 */
+	sf::Vector2f pointOnSegment(std::size_t segment, float distance) const {
+		const float t = (distance - m_arcLengths[segment]) * m_invSegmentLengths[segment];
+		return m_points[segment] + m_deltas[segment] * t;
+	}
+
+	std::vector<sf::Vector2f> m_points;      ///< Puntos; el tramo i va de points[i] a points[i + 1].
+	std::vector<sf::Vector2f> m_deltas;      ///< points[i + 1] - points[i].
+	std::vector<float> m_segmentLengths;     ///< Largo de cada tramo.
+	std::vector<float> m_invSegmentLengths;  ///< 1 / largo de cada tramo, o 0 si mide 0.
+	std::vector<float> m_arcLengths;         ///< Longitud de arco acumulada; un elemento ms que tramos.
+	float m_length = 0.0f;                   ///< Longitud total.
+	float m_invLength = 0.0f;                ///< 1 / longitud total, o 0 si mide 0.
+	bool m_closed = false;                   ///< Si el recorrido se repite.
+};
+
+/**
+ * @brief Puntero compartido a un recorrido.
+ */
+using PathAssetPtr = EngineUtilities::TSharedPointer<PathAsset>;
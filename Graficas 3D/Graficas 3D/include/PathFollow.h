@@ -0,0 +1,82 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+#include "PathAsset.h"
+
+class Window;
+
+/**
+ * @class PathFollow
+ * @brief Componente que mueve un actor a lo largo de un recorrido compartido.
+ *
+ * Solo guarda el recorrido, la velocidad y la distancia recorrida; la posicin sale
+ * de la longitud de arco del recorrido. Este componente no se mueve solo: lo hace
+ * `PathFollowSystem`, que actualiza por lotes a todos los que siguen el mismo
+ * recorrido y escribe la posicin en el `ShapeFactory` del actor.
+ */
+class PathFollow : public Component {
+public:
+	/**
+	 * @brief Constructor por defecto; sin recorrido, el actor no se mueve.
+	 */
+	PathFollow() : Component(ComponentType::PATH_FOLLOW) {}
+
+	/**
+	 * @brief Constructor.
+	 * @param path Recorrido a seguir.
+	 * @param speed Velocidad, en unidades por segundo.
+	 * @param startDistance Distancia desde la que empieza.
+	 */
+	PathFollow(PathAssetPtr path, float speed, float startDistance = 0.0f)
+		: Component(ComponentType::PATH_FOLLOW), m_path(std::move(path)), m_speed(speed) {
+		setDistance(startDistance);
+	}
+
+	/**
+	 * @brief Cambia el recorrido.
+	 * @param path Recorrido nuevo, o uno vaco para detenerse.
+	 * @param startDistance Distancia desde la que empieza.
+	 */
+	void setPath(PathAssetPtr path, float startDistance = 0.0f) {
+		m_path = std::move(path);
+		setDistance(startDistance);
+	}
+
+	/**
+	 * @brief Obtiene el recorrido, o nullptr si no tiene.
+	 */
+	const PathAsset* getPath() const { return m_path.get(); }
+
+	void setSpeed(float speed) { m_speed = speed; }
+	float getSpeed() const { return m_speed; }
+
+	/**
+	 * @brief Cambia la distancia recorrida; se lleva al rango del recorrido.
+	 */
+	void setDistance(float distance) { m_distance = m_path ? m_path->wrap(distance) : 0.0f; }
+	float getDistance() const { return m_distance; }
+
+	/**
+	 * @brief Indica si lleg al final de un recorrido abierto.
+	 */
+	bool isFinished() const {
+		return m_path && !m_path->isClosed() && m_distance >= m_path->getLength();
+	}
+
+	/**
+	 * @brief No hace nada; el movimiento lo hace `PathFollowSystem`.
+	 */
+	void update(float deltaTime) override {}
+
+	/**
+	 * @brief No dibuja nada.
+	 */
+	void render(Window& window) override {}
+
+private:
+	friend class PathFollowSystem;
+
+	PathAssetPtr m_path;      ///< Recorrido compartido.
+	float m_speed = 0.0f;     ///< Velocidad, en unidades por segundo.
+	float m_distance = 0.0f;  ///< Distancia recorrida, dentro del rango del recorrido.
+};
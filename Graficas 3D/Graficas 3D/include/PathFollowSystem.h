@@ -0,0 +1,49 @@
+#pragma once
+#include "Prerequisites.h"
+#include "System.h"
+#include "EntityRegistry.h"
+#include "PathFollow.h"
+#include <unordered_map>
+
+/**
+ * @class PathFollowSystem
+ * @brief Sistema que mueve por lotes a los actores con `PathFollow`.
+ *
+ * Agrupa a los actores por recorrido. Para cada grupo copia distancias y velocidades a
+ * arreglos contiguos, las avanza en un ciclo simple que el compilador puede vectorizar,
+ * calcula las posiciones con `PathAsset::sampleBatch` repartiendo el grupo en el
+ * `JobSystem`, y al final escribe distancias y posiciones de vuelta en los actores.
+ */
+class PathFollowSystem : public System {
+public:
+    /**
+     * @brief Constructor.
+     * @param actors Registro de actores de la aplicacin.
+     */
+    explicit PathFollowSystem(EntityRegistry& actors);
+
+    /**
+     * @brief Avanza a todos los actores por su recorrido.
+     * @param world World de la aplicacin (no se usa).
+     * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+     */
+    void update(World& world, float deltaTime) override;
+
+private:
+    /**
+     * @brief Actores que siguen un mismo recorrido, con su estado en arreglos SoA.
+     */
+    struct Batch {
+        const PathAsset* path = nullptr; ///< Recorrido del grupo.
+        std::vector<Entity*> agents;     ///< Actores del grupo.
+        std::vector<float> distance;     ///< Distancia recorrida de cada actor.
+        std::vector<float> speed;        ///< Velocidad de cada actor.
+        std::vector<float> positionX;    ///< Posicin X resultante.
+        std::vector<float> positionY;    ///< Posicin Y resultante.
+    };
+
+    EntityRegistry& m_actors;                                   ///< Registro de actores de la aplicacin.
+    std::vector<Batch> m_batches;                               ///< Grupos; se reutilizan entre fotogramas.
+    std::size_t m_batchCount = 0;                               ///< Grupos en uso en este fotograma.
+    std::unordered_map<const PathAsset*, std::size_t> m_batchOf; ///< Grupo de cada recorrido.
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include "Prerequisites.h"
+#include "EntityRegistry.h"
+#include "JobSystem.h"
+#include "NavGrid.h"
+#include "Pathfinder.h"
+#include "PathFollow.h"
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @class PathService
+ * @brief Servicio de caminos: calcula caminos A* en el `JobSystem` y se los da a `PathFollow`.
+ *
+ * `requestPath` no busca nada: anota la peticin y regresa. `update`, una vez por
+ * fotograma en el hilo principal, reparte las bsquedas pendientes en trabajos pequeos
+ * sin esperarlos, recoge los que ya terminaron y le pasa el resultado a cada actor con
+ * `PathFollow::setPath`. As, aunque cientos de actores pidan camino a la vez, el
+ * fotograma nunca espera a una bsqueda.
+ *
+ * Los caminos se identifican por celda de inicio y celda de destino. Los resultados
+ * recientes se guardan en una cach LRU, incluidos los que no tienen camino, y varios
+ * actores que piden el mismo par comparten una sola bsqueda y el mismo `PathAsset`.
+ *
+ * `requestPath`, `update`, `setGrid` y `clear` solo se llaman desde el hilo principal.
+ */
+class PathService {
+public:
+	/**
+	 * @brief Constructor.
+	 * @param actors Registro de actores de la aplicacin.
+	 * @param cacheCapacity Caminos que guarda la cach.
+	 */
+	explicit PathService(EntityRegistry& actors, std::size_t cacheCapacity = 256);
+
+	/**
+	 * @brief Espera a las bsquedas en curso.
+	 */
+	~PathService();
+
+	PathService(const PathService&) = delete;
+	PathService& operator=(const PathService&) = delete;
+
+	/**
+	 * @brief Cambia la rejilla de navegacin.
+	 * @param grid Rejilla nueva.
+	 *
+	 * Espera a las bsquedas en curso, descarta sus resultados y vaca la cach. Las
+	 * peticiones pendientes se vuelven a buscar con la rejilla nueva: sus celdas se
+	 * recalculan a partir de las posiciones de mundo guardadas al pedirlas.
+	 */
+	void setGrid(NavGrid grid);
+
+	/**
+	 * @brief Obtiene la rejilla de navegacin.
+	 */
+	const NavGrid& getGrid() const { return m_grid; }
+
+	/**
+	 * @brief Pide un camino desde la posicin actual de un actor.
+	 * @param agent Actor con `PathFollow` y `ShapeFactory`.
+	 * @param goal Destino en coordenadas de mundo.
+	 *
+	 * Si el camino est en la cach se entrega en el acto; si no, se entrega en un
+	 * `update` posterior. Si no hay camino, el actor recibe un recorrido vaco y se
+	 * detiene. Una peticin nueva del mismo actor reemplaza a la anterior.
+	 */
+	void requestPath(ActorHandle agent, const sf::Vector2f& goal);
+
+	/**
+	 * @brief Indica si un actor espera un camino.
+	 */
+	bool isPending(ActorHandle agent) const { return m_requests.count(handleKey(agent)) != 0; }
+
+	/**
+	 * @brief Entrega los caminos terminados y lanza las bsquedas pendientes.
+	 *
+	 * No espera a ninguna bsqueda. Lanza a lo sumo `setSearchBudget` bsquedas por
+	 * fotograma; las dems quedan en cola.
+	 */
+	void update();
+
+	/**
+	 * @brief Cambia cuntas bsquedas se lanzan por fotograma.
+	 */
+	void setSearchBudget(std::size_t budget) { m_searchBudget = budget; }
+
+	/**
+	 * @brief Espera a las bsquedas en curso y descarta peticiones y cach.
+	 */
+	void clear();
+
+	/**
+	 * @brief Escribe las estadsticas del servicio.
+	 * @param os Flujo de salida.
+	 */
+	void dumpStats(std::ostream& os) const;
+
+private:
+	/**
+	 * @brief Una bsqueda: la hace un trabajador y la lee el hilo principal.
+	 */
+	struct Search {
+		std::uint64_t key = 0;             ///< Celda de inicio y de destino.
+		std::vector<std::uint32_t> cells;  ///< Celdas del camino.
+		PathAssetPtr path;                 ///< Camino resultante, o vaco si no hay.
+	};
+
+	/**
+	 * @brief Bsquedas lanzadas juntas en un trabajo.
+	 */
+	struct Batch {
+		std::vector<Search> searches;   ///< Bsquedas del trabajo.
+		JobCounter counter;             ///< Llega a cero cuando el trabajo termina.
+	};
+
+	/**
+	 * @brief Peticin pendiente de un actor.
+	 *
+	 * Guarda las posiciones de mundo para poder recalcular las celdas si cambia la rejilla.
+	 */
+	struct Request {
+		ActorHandle agent;     ///< Actor que pidi el camino.
+		sf::Vector2f start;    ///< Posicin del actor al pedirlo.
+		sf::Vector2f goal;     ///< Destino.
+		std::uint64_t key = 0; ///< Celda de inicio y de destino en la rejilla actual.
+	};
+
+	/**
+	 * @brief Entrada de la cach.
+	 */
+	struct CacheEntry {
+		std::uint64_t key;   ///< Celda de inicio y de destino.
+		PathAssetPtr path;   ///< Camino, o vaco si no hay.
+	};
+
+	static std::uint64_t handleKey(ActorHandle handle) {
+		return (static_cast<std::uint64_t>(handle.generation) << 32) | handle.index;
+	}
+
+	void runBatch(Batch& batch);
+	PathAssetPtr buildPath(const std::vector<std::uint32_t>& cells) const;
+	void collect();
+	void dispatch();
+	void waitInFlight();
+	void enqueue(const Request& request);
+	void deliver(std::uint64_t key, const PathAssetPtr& path);
+	const PathAssetPtr* findCached(std::uint64_t key);
+	void insertCached(std::uint64_t key, const PathAssetPtr& path);
+
+	EntityRegistry& m_actors;     ///< Registro de actores de la aplicacin.
+	NavGrid m_grid;               ///< Rejilla de navegacin.
+
+	std::list<CacheEntry> m_cache;                                               ///< Cach; la ms reciente al frente.
+	std::unordered_map<std::uint64_t, std::list<CacheEntry>::iterator> m_cacheIndex; ///< Entrada de cada par.
+	std::size_t m_cacheCapacity;                                                 ///< Mximo de entradas.
+
+	std::vector<std::uint64_t> m_queued;                                         ///< Pares por lanzar, en orden de llegada.
+	std::unordered_map<std::uint64_t, std::vector<ActorHandle>> m_waiting;       ///< Actores que esperan cada par.
+	std::unordered_map<std::uint64_t, Request> m_requests;                       ///< ltima peticin pendiente de cada actor.
+	std::vector<std::unique_ptr<Batch>> m_inFlight;                              ///< Trabajos lanzados.
+	std::vector<std::unique_ptr<Batch>> m_freeBatches;                           ///< Trabajos para reutilizar.
+	std::size_t m_searchBudget = 64;                                             ///< Bsquedas lanzadas por fotograma.
+
+	EngineUtilities::SpinLock m_pathfinderLock;                                  ///< Protege `m_pathfinders`.
+	std::vector<std::unique_ptr<Pathfinder>> m_pathfinders;                      ///< Buscadores libres, uno por hilo.
+
+	std::uint64_t m_requestCount = 0; ///< Peticiones recibidas.
+	std::uint64_t m_cacheHits = 0;   ///< Peticiones resueltas con la cach.
+	std::uint64_t m_searches = 0;    ///< Bsquedas terminadas.
+	std::uint64_t m_failures = 0;    ///< Bsquedas sin camino.
+};
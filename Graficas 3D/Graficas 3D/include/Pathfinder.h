@@ -0,0 +1,68 @@
+#pragma once
+#include "Prerequisites.h"
+#include "NavGrid.h"
+
+/**
+ * @class Pathfinder
+ * @brief Bsqueda A* sobre una `NavGrid`, con memoria reservada de antemano.
+ *
+ * Guarda un nodo por celda en un arreglo que se reserva una sola vez. En lugar de
+ * limpiarlo antes de cada bsqueda, cada nodo lleva la generacin de la bsqueda que
+ * lo toc por ltima vez: un nodo con otra generacin cuenta como no visitado. La lista
+ * abierta es un montculo binario que tambin conserva su memoria entre bsquedas; las
+ * entradas obsoletas se descartan al sacarlas, en lugar de reordenar el montculo.
+ *
+ * Se mueve en 8 direcciones sin cortar esquinas ocupadas, con la distancia octil como
+ * heurstica. Una instancia no se puede usar desde dos hilos a la vez.
+ */
+class Pathfinder {
+public:
+	/**
+	 * @brief Constructor.
+	 * @param cellCount Celdas de la rejilla ms grande que se va a usar.
+	 */
+	explicit Pathfinder(std::size_t cellCount = 0);
+
+	/**
+	 * @brief Busca el camino ms corto entre dos celdas.
+	 * @param grid Rejilla de navegacin.
+	 * @param start Celda de inicio; no necesita estar libre.
+	 * @param goal Celda de destino.
+	 * @param cells Recibe las celdas del camino, de `start` a `goal`.
+	 * @return false si el destino est ocupado o no se puede alcanzar.
+	 */
+	bool findPath(const NavGrid& grid, std::uint32_t start, std::uint32_t goal, std::vector<std::uint32_t>& cells);
+
+	/**
+	 * @brief Nodos expandidos en la ltima bsqueda.
+	 */
+	std::size_t getExpandedCount() const { return m_expanded; }
+
+private:
+	/**
+	 * @brief Estado de una celda durante una bsqueda.
+	 */
+	struct Node {
+		float cost = 0.0f;               ///< Costo desde el inicio.
+		std::uint32_t parent = 0;        ///< Celda anterior en el mejor camino conocido.
+		std::uint32_t generation = 0;    ///< Bsqueda en que se toc; si no es la actual, no est visitado.
+		bool closed = false;             ///< Si ya se expandi.
+	};
+
+	/**
+	 * @brief Entrada de la lista abierta.
+	 */
+	struct OpenEntry {
+		float priority;       ///< Costo ms heurstica.
+		float cost;           ///< Costo con que se agreg; si el nodo mejor despus, est obsoleta.
+		std::uint32_t cell;   ///< Celda.
+	};
+
+	void push(const OpenEntry& entry);
+	OpenEntry pop();
+
+	std::vector<Node> m_nodes;        ///< Un nodo por celda.
+	std::vector<OpenEntry> m_open;    ///< Montculo binario de mnimos por prioridad.
+	std::uint32_t m_generation = 0;   ///< Generacin de la bsqueda actual.
+	std::size_t m_expanded = 0;       ///< Nodos expandidos en la ltima bsqueda.
+};
@@ -13,6 +13,10 @@
 #include "Memory\TWeakPointer.h"
 #include "Memory\TStaticPtr.h"
 #include "Memory\TUniquePtr.h"
+#include "Memory\TIntrusivePtr.h"
+#include "Memory\FrameArena.h"
+#include "Memory\THandle.h"
+#include "Memory\MemoryTracker.h"
 
 /**
  * @enum ShapeType
@@ -0,0 +1,169 @@
+#pragma once
+#include "Prerequisites.h"
+#include "GeometryCache.h"
+#include <cstdint>
+#include <unordered_map>
+
+class SoftwareRasterizer;
+
+/**
+ * @struct DrawOrder
+ * @brief Datos de orden de un dibujo: capa, profundidad y modo de mezcla.
+ *
+ * Las capas menores se dibujan primero. Dentro de una capa y un mismo estado
+ * (mezcla y textura), la profundidad menor se dibuja primero.
+ */
+struct DrawOrder {
+	std::uint8_t layer = 0;                   ///< Capa de dibujo.
+	float depth = 0.0f;                       ///< Profundidad dentro de la capa.
+	sf::BlendMode blendMode = sf::BlendAlpha; ///< Modo de mezcla.
+};
+
+/**
+ * @class RenderQueue
+ * @brief Cola de geometra que ordena los dibujos por estado y los agrupa en pocos `sf::VertexArray`.
+ *
+ * Cada `submit` convierte la forma en tringulos (ya transformados y con su color) y
+ * guarda un dibujo con una clave de orden de 64 bits:
+ *
+ * | bits  | campo                                   |
+ * |-------|-----------------------------------------|
+ * | 56-63 | capa                                    |
+ * | 52-55 | modo de mezcla (ndice, hasta 16)       |
+ * | 32-51 | textura (ndice, 0 = sin textura)       |
+ * | 0-31  | profundidad (float ordenable como uint) |
+ *
+ * En `flush` las claves se ordenan con radix sort y los dibujos consecutivos que comparten
+ * mezcla y textura se unen en un solo lote, que es una sola llamada de dibujo. El orden es
+ * estable: dibujos con la misma clave conservan el orden en que se enviaron.
+ *
+ * Los buffers se reutilizan entre fotogramas para no volver a reservar memoria.
+ */
+class RenderQueue {
+public:
+	RenderQueue() = default;
+
+	/**
+	 * @brief Agrega el relleno y el contorno de una forma a la cola.
+	 * @param shape Forma a dibujar; se copia su geometra, no hace falta que siga viva.
+	 * @param order Capa, profundidad y modo de mezcla.
+	 *
+	 * El contorno nunca lleva textura, as que en una forma con textura se ordena con
+	 * la geometra sin textura de su capa.
+	 */
+	void submit(const sf::Shape& shape, const DrawOrder& order = DrawOrder());
+
+	/**
+	 * @brief Agrega una copia de una geometra compartida a la cola.
+	 * @param mesh Geometra en espacio local.
+	 * @param transform Transformacin de la copia.
+	 * @param color Color de relleno de la copia.
+	 * @param order Capa, profundidad y modo de mezcla.
+	 *
+	 * Los tringulos ya vienen armados en la geometra; solo se transforman.
+	 */
+	void submit(const ShapeMesh& mesh, const sf::Transform& transform, const sf::Color& color,
+	            const DrawOrder& order = DrawOrder());
+
+	/**
+	 * @brief Ordena, agrupa y dibuja todo lo pendiente, y vaca la cola.
+	 * @param target Destino de dibujo.
+	 */
+	void flush(sf::RenderTarget& target);
+
+	/**
+	 * @brief Ordena, agrupa y manda todo lo pendiente al rasterizador por CPU, y vaca la cola.
+	 * @param rasterizer Rasterizador destino.
+	 */
+	void flush(SoftwareRasterizer& rasterizer);
+
+	/**
+	 * @brief Descarta los dibujos pendientes sin dibujarlos.
+	 */
+	void clear();
+
+	/**
+	 * @brief Arma la clave de orden de un dibujo.
+	 * @param layer Capa.
+	 * @param blendIndex ndice del modo de mezcla (4 bits).
+	 * @param textureIndex ndice de la textura (20 bits, 0 = sin textura).
+	 * @param depth Profundidad.
+	 */
+	static std::uint64_t makeSortKey(std::uint8_t layer, std::uint32_t blendIndex,
+	                                 std::uint32_t textureIndex, float depth);
+
+	/**
+	 * @brief Nmero de llamadas de dibujo del ltimo `flush`.
+	 */
+	std::size_t lastDrawCalls() const { return m_lastDrawCalls; }
+
+	/**
+	 * @brief Nmero de formas enviadas en el ltimo `flush`.
+	 */
+	std::size_t lastSubmitted() const { return m_lastSubmitted; }
+
+private:
+	/**
+	 * @brief Dibujo pendiente: un rango de vrtices y su estado.
+	 */
+	struct DrawItem {
+		std::uint64_t key = 0;                ///< Clave de orden.
+		std::uint32_t firstVertex = 0;        ///< Primer vrtice en `m_vertices`.
+		std::uint32_t vertexCount = 0;        ///< Nmero de vrtices.
+		const sf::Texture* texture = nullptr; ///< Textura, o nullptr.
+		std::uint32_t blendIndex = 0;         ///< ndice en `m_blendModes`.
+	};
+
+	/**
+	 * @brief Lote de tringulos que comparten textura y modo de mezcla.
+	 */
+	struct Batch {
+		const sf::Texture* texture = nullptr;      ///< Textura del lote, o nullptr.
+		std::uint32_t blendIndex = 0;              ///< ndice en `m_blendModes`.
+		sf::VertexArray vertices{ sf::Triangles }; ///< Tringulos del lote.
+	};
+
+	/**
+	 * @brief Abre un dibujo con los vrtices que se agreguen a continuacin.
+	 */
+	void beginItem(const sf::Texture* texture, const DrawOrder& order);
+
+	/**
+	 * @brief Cierra el dibujo abierto; lo descarta si no tiene vrtices.
+	 */
+	void endItem();
+
+	/**
+	 * @brief Ordena los dibujos pendientes y arma los lotes.
+	 */
+	void buildBatches();
+
+	/**
+	 * @brief Ordena `m_order` por clave con radix sort LSD de 8 bits por pasada.
+	 */
+	void sortItems();
+
+	/**
+	 * @brief Obtiene el ndice de una textura para la clave (0 = sin textura).
+	 */
+	std::uint32_t textureIndex(const sf::Texture* texture);
+
+	/**
+	 * @brief Obtiene el ndice de un modo de mezcla para la clave.
+	 */
+	std::uint32_t blendIndex(const sf::BlendMode& blendMode);
+
+	std::vector<sf::Vertex> m_vertices;   ///< Vrtices de todos los dibujos pendientes.
+	std::vector<DrawItem> m_items;        ///< Dibujos pendientes, en orden de envo.
+	std::vector<std::uint32_t> m_order;   ///< ndices de `m_items` ordenados por clave.
+	std::vector<std::uint32_t> m_scratch; ///< Buffer auxiliar del radix sort.
+	std::vector<Batch> m_batches;         ///< Lotes; solo los primeros `m_batchCount` estn en uso.
+	std::size_t m_batchCount = 0;         ///< Lotes en uso en el ltimo flush.
+
+	std::unordered_map<const sf::Texture*, std::uint32_t> m_textureIds; ///< ndices de textura.
+	std::vector<sf::BlendMode> m_blendModes;                            ///< Modos de mezcla por ndice.
+
+	std::size_t m_submitted = 0;     ///< Formas enviadas en este fotograma.
+	std::size_t m_lastDrawCalls = 0; ///< Llamadas de dibujo del ltimo flush.
+	std::size_t m_lastSubmitted = 0; ///< Formas del ltimo flush.
+};
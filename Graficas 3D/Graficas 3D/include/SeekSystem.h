@@ -0,0 +1,43 @@
+#pragma once
+#include "Prerequisites.h"
+#include "System.h"
+#include "EntityRegistry.h"
+#include "SeekTarget.h"
+
+/**
+ * @class SeekSystem
+ * @brief Sistema que mueve por lotes a los actores con `SeekTarget`.
+ *
+ * Copia posiciones, objetivos y velocidades de todos los actores a arreglos SoA, los
+ * mueve con `SteeringKernels::parallelSeek` (o `parallelArrive` si hay radio de frenado)
+ * y escribe las posiciones de vuelta con `SteeringKernels::scatterPositions`.
+ */
+class SeekSystem : public System {
+public:
+    /**
+     * @brief Constructor.
+     * @param actors Registro de actores de la aplicacin.
+     * @param slowingRadius Distancia desde la que los actores frenan; 0 para no frenar.
+     * @param range Distancia al objetivo a la que un actor ya no se mueve.
+     */
+    SeekSystem(EntityRegistry& actors, float slowingRadius = 0.0f, float range = 1.0f);
+
+    /**
+     * @brief Mueve a todos los actores hacia su objetivo.
+     * @param world World de la aplicacin (no se usa).
+     * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+     */
+    void update(World& world, float deltaTime) override;
+
+private:
+    EntityRegistry& m_actors;        ///< Registro de actores de la aplicacin.
+    float m_slowingRadius;           ///< Radio de frenado; 0 para Seek.
+    float m_range;                   ///< Distancia a la que ya no se mueven.
+
+    std::vector<ShapeFactory*> m_shapes; ///< Formas del lote; se reutiliza.
+    std::vector<float> m_positionX;      ///< Posicin X del lote.
+    std::vector<float> m_positionY;      ///< Posicin Y del lote.
+    std::vector<float> m_targetX;        ///< Objetivo X del lote.
+    std::vector<float> m_targetY;        ///< Objetivo Y del lote.
+    std::vector<float> m_speed;          ///< Velocidad del lote.
+};
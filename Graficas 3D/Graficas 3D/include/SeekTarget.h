@@ -0,0 +1,44 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Component.h"
+
+class Window;
+
+/**
+ * @class SeekTarget
+ * @brief Componente que lleva a un actor hacia un punto.
+ *
+ * Solo guarda el objetivo y la velocidad; el movimiento lo hace `SeekSystem`, que
+ * procesa a todos los actores con este componente en un solo lote de
+ * `SteeringKernels`.
+ */
+class SeekTarget : public Component {
+public:
+	/**
+	 * @brief Constructor.
+	 * @param target Punto al que se dirige el actor.
+	 * @param speed Velocidad mxima, en unidades por segundo.
+	 */
+	SeekTarget(const sf::Vector2f& target = sf::Vector2f(), float speed = 0.0f)
+		: Component(ComponentType::SEEK_TARGET), m_target(target), m_speed(speed) {}
+
+	void setTarget(const sf::Vector2f& target) { m_target = target; }
+	const sf::Vector2f& getTarget() const { return m_target; }
+
+	void setSpeed(float speed) { m_speed = speed; }
+	float getSpeed() const { return m_speed; }
+
+	/**
+	 * @brief No hace nada; el movimiento lo hace `SeekSystem`.
+	 */
+	void update(float deltaTime) override {}
+
+	/**
+	 * @brief No dibuja nada.
+	 */
+	void render(Window& window) override {}
+
+private:
+	sf::Vector2f m_target;  ///< Punto al que se dirige el actor.
+	float m_speed = 0.0f;   ///< Velocidad mxima, en unidades por segundo.
+};
@@ -2,6 +2,8 @@
 #include "Prerequisites.h"
 #include "Component.h"
 #include "Window.h"
+#include "GeometryCache.h"
+#include "AABBTree.h"
 
 /**
  * @class ShapeFactory
@@ -11,8 +13,17 @@
  * diferentes tipos de formas (como crculos, rectngulos y tringulos) y
  * manejar sus propiedades, como posicin y color de relleno. Esta clase
  * hereda de `Component` y se integra en el sistema de componentes del juego.
+ *
+ * La geometra no es propia de cada instancia: se pide a `GeometryCache` y la
+ * comparten todas las formas del mismo tipo y tamao. Cada `ShapeFactory` solo
+ * guarda su transformacin y su color. Los `ShapeFactory` se reservan en un pool
+ * (`TPoolAllocator`), sin pasar por el asignador global.
+ *
+ * Si la forma est conectada a un ndice espacial (`attachSpatialIndex`), su caja
+ * global se mantiene al da en el rbol cada vez que se crea la forma o se mueve con
+ * `setPosition` o `Seek`.
  */
-class ShapeFactory : public Component {
+class ShapeFactory : public Component, public EngineUtilities::TPooledObject<ShapeFactory> {
 public:
 	/**
 	 * @brief Constructor por defecto.
@@ -24,9 +35,9 @@ public:
 	/**
 	 * @brief Destructor virtual.
 	 *
-	 * Libera los recursos asociados a la instancia de `ShapeFactory`.
+	 * Suelta la referencia a la geometra compartida y sale del ndice espacial.
 	 */
-	virtual ~ShapeFactory() = default;
+	virtual ~ShapeFactory();
 
 	/**
 	 * @brief Constructor que inicializa el tipo de forma.
@@ -36,17 +47,17 @@ public:
 	 * correspondiente.
 	 */
 	ShapeFactory(ShapeType shapeType) :
-		m_shape(nullptr), m_shapeType(ShapeType::EMPTY), Component(ComponentType::SHAPE) {}
+		m_shapeType(ShapeType::EMPTY), Component(ComponentType::SHAPE) {}
 
 	/**
 	 * @brief Crea una forma segn el tipo especificado.
 	 * @param shapeType Tipo de forma que se desea crear.
-	 * @return Puntero a la forma creada, o nullptr si no se puede crear.
+	 * @return Puntero a la geometra de la forma, o nullptr si no se puede crear.
 	 *
-	 * Este mtodo utiliza el tipo de forma proporcionado para instanciar y
-	 * devolver la forma correspondiente.
+	 * Este mtodo obtiene del cach la geometra del tipo de forma
+	 * proporcionado y restablece el color a blanco.
 	 */
-	sf::Shape* createShape(ShapeType shapeType);
+	const ShapeMesh* createShape(ShapeType shapeType);
 
 	/**
 	 * @brief Actualiza el componente de forma.
@@ -64,7 +75,7 @@ public:
 	 * Este mtodo no realiza ninguna accin, pero debe ser implementado
 	 * para cumplir con la interfaz de `Component`.
 	 */
-	void render(Window window) override {}
+	void render(Window& window) override {}
 
 	/**
 	 * @brief Establece la posicin de la forma.
@@ -107,17 +118,96 @@ public:
 	void Seek(const sf::Vector2f& targetPosition, float speed, float deltaTime, float range);
 
 	/**
-	 * @brief Obtiene la forma creada.
-	 * @return Puntero a la forma actual.
+	 * @brief Obtiene la geometra compartida de la forma.
+	 * @return Puntero a la geometra, o nullptr si no se ha creado una forma.
+	 */
+	const ShapeMesh* getMesh() const {
+		return m_mesh.get();
+	}
+
+	/**
+	 * @brief Obtiene la posicin de la forma.
+	 */
+	const sf::Vector2f& getPosition() const {
+		return m_transformable.getPosition();
+	}
+
+	/**
+	 * @brief Obtiene la caja de la forma en espacio de mundo.
+	 * @return La caja, o un rectngulo vaco si no se ha creado una forma.
+	 */
+	sf::FloatRect getGlobalBounds() const;
+
+	/**
+	 * @brief Conecta la forma a un ndice espacial.
+	 * @param tree rbol donde registrar la caja de la forma; debe vivir ms que la forma.
+	 * @param userData Dato que devuelven las consultas al rbol.
+	 */
+	void attachSpatialIndex(AABBTree* tree, void* userData);
+
+	/**
+	 * @brief Saca la forma de su ndice espacial, si tiene uno.
+	 */
+	void detachSpatialIndex();
+
+	/**
+	 * @brief Actualiza la caja de la forma en su ndice espacial.
 	 *
-	 * Este mtodo devuelve el puntero a la forma actualmente gestionada
-	 * por la instancia de `ShapeFactory`.
+	 * `createShape`, `setPosition` y `Seek` la llaman solos; hay que llamarla a mano
+	 * despus de cambiar la forma con `getTransformable`.
+	 */
+	void updateBounds();
+
+	/**
+	 * @brief Obtiene la transformacin de espacio local a espacio de mundo.
+	 */
+	const sf::Transform& getTransform() const {
+		return m_transformable.getTransform();
+	}
+
+	/**
+	 * @brief Obtiene la posicin, rotacin, escala y origen de la forma.
+	 */
+	sf::Transformable& getTransformable() {
+		return m_transformable;
+	}
+
+	/**
+	 * @brief Obtiene el color de relleno de la forma.
+	 */
+	const sf::Color& getFillColor() const {
+		return m_fillColor;
+	}
+
+	/**
+	 * @brief Establece la capa, profundidad y modo de mezcla con que se dibuja la forma.
+	 * @param order Datos de orden de dibujo.
+	 */
+	void setDrawOrder(const DrawOrder& order) {
+		m_drawOrder = order;
+	}
+
+	/**
+	 * @brief Obtiene los datos de orden de dibujo de la forma.
+	 */
+	const DrawOrder& getDrawOrder() const {
+		return m_drawOrder;
+	}
+
+	/**
+	 * @brief Obtiene el tipo de forma actual.
 	 */
-	sf::Shape* getShape() {
-		return m_shape;
+	ShapeType getShapeType() const {
+		return m_shapeType;
 	}
 
 private:
-	sf::Shape* m_shape; ///< Puntero a la forma creada.
-	ShapeType m_shapeType; ///< Tipo de forma actual.
+	ShapeMeshPtr m_mesh; ///< Geometra compartida, del cach.
+	sf::Transformable m_transformable; ///< Transformacin propia de la forma.
+	sf::Color m_fillColor = sf::Color::White; ///< Color de relleno.
+	DrawOrder m_drawOrder; ///< Capa, profundidad y modo de mezcla.
+	AABBTree* m_spatialIndex = nullptr; ///< ndice espacial, o nullptr.
+	void* m_spatialUserData = nullptr; ///< Dato de la forma en el ndice.
+	int m_proxyId = AABBTree::NullNode; ///< Proxy de la forma en el ndice.
+	ShapeType m_shapeType = ShapeType::EMPTY; ///< Tipo de forma actual.
 };
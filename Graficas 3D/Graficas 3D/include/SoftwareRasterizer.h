@@ -0,0 +1,184 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+/**
+ * @struct RasterizerStats
+ * @brief Estadsticas del ltimo `SoftwareRasterizer::resolve`.
+ */
+struct RasterizerStats {
+	std::size_t triangles = 0;      ///< Tringulos recibidos.
+	std::size_t binnedTriangles = 0; ///< Suma de tringulos por tile (un tringulo cuenta en cada tile que toca).
+	std::size_t tilesTouched = 0;   ///< Tiles con al menos un tringulo.
+	double resolveMicroseconds = 0.0; ///< Tiempo de rasterizado.
+};
+
+/**
+ * @class SoftwareRasterizer
+ * @brief Rasterizador por CPU que dibuja tringulos en un framebuffer RGBA en memoria.
+ *
+ * Sirve de backend para `Window` en mquinas sin GPU ni pantalla. Recibe los mismos
+ * vrtices que se le mandaran a `sf::RenderTarget` (en coordenadas de mundo, con su
+ * color) y los pasa a pxeles con la vista actual, igual que SFML.
+ *
+ * El trabajo se divide en dos fases:
+ * - `drawTriangles` prepara cada tringulo (funciones de arista y caja en pxeles) y lo
+ *   reparte en los tiles de `TileSize` x `TileSize` que toca, en orden de llegada.
+ * - `resolve` rasteriza los tiles en paralelo con el `JobSystem`. Cada tile procesa sus
+ *   tringulos en orden, as que el resultado es el mismo que dibujar en serie, y
+ *   ningn pxel se escribe desde dos hilos.
+ *
+ * Dentro de un tile se evalan las funciones de arista de cuatro pxeles a la vez con
+ * SSE2 cuando est disponible. La cobertura sigue la regla top-left, as que dos
+ * tringulos que comparten una arista no pintan dos veces el mismo pxel.
+ *
+ * No muestrea texturas (leer un `sf::Texture` requiere GPU): la geometra con textura
+ * se pinta solo con el color de sus vrtices. Mezclas soportadas: `sf::BlendAlpha`,
+ * `sf::BlendAdd`, `sf::BlendMultiply` y `sf::BlendNone`; cualquier otra se trata como alfa.
+ */
+class SoftwareRasterizer {
+public:
+	/// Lado de un tile en pxeles; mltiplo de 4 por el ancho de SIMD.
+	static constexpr unsigned TileSize = 64;
+
+	SoftwareRasterizer() = default;
+
+	/**
+	 * @brief Crea el framebuffer.
+	 * @param width Ancho en pxeles.
+	 * @param height Alto en pxeles.
+	 *
+	 * Restablece la vista a la predeterminada, que cubre (0, 0)-(width, height).
+	 */
+	void create(unsigned width, unsigned height);
+
+	/**
+	 * @brief Cambia la vista con que se pasan las coordenadas de mundo a pxeles.
+	 */
+	void setView(const sf::View& view);
+
+	/**
+	 * @brief Obtiene la vista actual.
+	 */
+	const sf::View& getView() const { return m_view; }
+
+	/**
+	 * @brief Obtiene el rectngulo de mundo que cubre la vista actual.
+	 */
+	sf::FloatRect getViewBounds() const;
+
+	/**
+	 * @brief Llena el framebuffer con un color.
+	 * @param color Color de fondo.
+	 *
+	 * Antes rasteriza lo pendiente, para respetar el orden.
+	 */
+	void clear(const sf::Color& color = sf::Color(0, 0, 0, 255));
+
+	/**
+	 * @brief Prepara y reparte en tiles una lista de tringulos.
+	 * @param vertices Vrtices en coordenadas de mundo, tres por tringulo.
+	 * @param count Nmero de vrtices.
+	 * @param blendMode Modo de mezcla.
+	 *
+	 * Los tringulos se dibujan en el siguiente `resolve`.
+	 */
+	void drawTriangles(const sf::Vertex* vertices, std::size_t count,
+	                   const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+	/**
+	 * @brief Rasteriza en paralelo los tringulos pendientes.
+	 */
+	void resolve();
+
+	/**
+	 * @brief Obtiene los pxeles, RGBA de 8 bits por canal, fila por fila.
+	 *
+	 * Antes rasteriza lo pendiente.
+	 */
+	const std::uint8_t* getPixels();
+
+	/**
+	 * @brief Obtiene el color de un pxel.
+	 */
+	sf::Color getPixel(unsigned x, unsigned y);
+
+	/**
+	 * @brief Guarda el framebuffer como imagen.
+	 * @param path Ruta del archivo; el formato sale de la extensin (png, bmp, tga, jpg).
+	 * @return true si se guard.
+	 */
+	bool saveToFile(const std::string& path);
+
+	unsigned getWidth() const { return m_width; }
+	unsigned getHeight() const { return m_height; }
+
+	/**
+	 * @brief Estadsticas del ltimo `resolve`.
+	 */
+	const RasterizerStats& lastStats() const { return m_stats; }
+
+private:
+	/**
+	 * @brief Modos de mezcla soportados.
+	 */
+	enum BlendOp : std::uint8_t {
+		BLEND_ALPHA = 0,
+		BLEND_ADD = 1,
+		BLEND_MULTIPLY = 2,
+		BLEND_NONE = 3
+	};
+
+	/**
+	 * @brief Tringulo preparado para rasterizar.
+	 *
+	 * La funcin de la arista i es `A[i] * x + B[i] * y + C[i]`, positiva del lado de
+	 * adentro, y vale el doble del rea del subtringulo opuesto al vrtice i.
+	 */
+	struct Triangle {
+		float A[3];
+		float B[3];
+		float C[3];
+		bool topLeft[3];   ///< Si la arista i es superior o izquierda (incluye sus pxeles).
+		float invArea;     ///< 1 / (doble del rea).
+		float color[3][4]; ///< Color RGBA (0-255) de cada vrtice.
+		int minX, minY, maxX, maxY; ///< Caja en pxeles, recortada al framebuffer.
+		BlendOp blend;
+	};
+
+	/**
+	 * @brief Pasa un punto de mundo a pxeles con la vista actual.
+	 */
+	sf::Vector2f mapToPixel(const sf::Vector2f& point) const;
+
+	/**
+	 * @brief Prepara un tringulo y lo agrega a los tiles que toca.
+	 */
+	void setupTriangle(const sf::Vertex& v0, const sf::Vertex& v1, const sf::Vertex& v2, BlendOp blend);
+
+	/**
+	 * @brief Rasteriza los tringulos de un tile.
+	 */
+	void rasterizeTile(std::size_t tileIndex);
+
+	/**
+	 * @brief Mezcla un color sobre un pxel.
+	 */
+	static void blendPixel(std::uint8_t* dst, const float src[4], BlendOp blend);
+
+	/**
+	 * @brief Traduce un `sf::BlendMode` a un modo soportado.
+	 */
+	static BlendOp toBlendOp(const sf::BlendMode& blendMode);
+
+	unsigned m_width = 0;  ///< Ancho en pxeles.
+	unsigned m_height = 0; ///< Alto en pxeles.
+	unsigned m_tilesX = 0; ///< Tiles por fila.
+	unsigned m_tilesY = 0; ///< Tiles por columna.
+	std::vector<std::uint8_t> m_pixels; ///< Framebuffer RGBA.
+	sf::View m_view;                    ///< Vista actual.
+
+	std::vector<Triangle> m_triangles;           ///< Tringulos pendientes.
+	std::vector<std::vector<std::uint32_t>> m_bins; ///< ndices de tringulos por tile, en orden.
+	RasterizerStats m_stats;                     ///< Estadsticas del ltimo resolve.
+};
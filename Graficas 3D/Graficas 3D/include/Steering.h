@@ -0,0 +1,187 @@
+#pragma once
+#include "Prerequisites.h"
+#include "UniformGrid.h"
+#include <cstdint>
+
+/**
+ * @struct WanderState
+ * @brief Estado por agente del comportamiento Wander.
+ */
+struct WanderState {
+	float angle = 0.0f;        ///< ngulo actual sobre el crculo de wander, en radianes.
+	std::uint32_t seed = 1;    ///< Estado del generador pseudoaleatorio; nunca 0.
+};
+
+/**
+ * @struct SteeringParams
+ * @brief Lmites y distancias que comparten los comportamientos.
+ */
+struct SteeringParams {
+	float maxSpeed = 120.0f;         ///< Velocidad mxima, en unidades por segundo.
+	float maxForce = 240.0f;         ///< Fuerza mxima tras mezclar, en unidades por segundo al cuadrado.
+	float slowingRadius = 80.0f;     ///< Arrive: distancia desde la que se frena.
+	float panicDistance = 150.0f;    ///< Flee y Evade: distancia a partir de la cual se ignora la amenaza.
+	float wanderRadius = 20.0f;      ///< Wander: radio del crculo.
+	float wanderDistance = 40.0f;    ///< Wander: distancia del crculo por delante del agente.
+	float wanderJitter = 4.0f;       ///< Wander: cunto puede girar el ngulo por segundo, en radianes.
+	float neighbourRadius = 50.0f;   ///< Alignment y Cohesion: radio de vecindad.
+	float separationRadius = 20.0f;  ///< Separation: distancia a la que se empieza a repeler.
+};
+
+/**
+ * @struct SteeringWeights
+ * @brief Peso de cada comportamiento en la mezcla; los de peso 0 no se calculan.
+ */
+struct SteeringWeights {
+	float seek = 0.0f;
+	float flee = 0.0f;
+	float arrive = 0.0f;
+	float wander = 0.0f;
+	float pursue = 0.0f;
+	float evade = 0.0f;
+	float separation = 0.0f;
+	float alignment = 0.0f;
+	float cohesion = 0.0f;
+};
+
+/**
+ * @brief Comportamientos de steering de Reynolds para un solo agente.
+ *
+ * Cada uno devuelve una fuerza: la diferencia entre la velocidad deseada y la actual.
+ * Se suman con pesos y la suma se recorta a `SteeringParams::maxForce`.
+ */
+namespace Steering {
+	/**
+	 * @brief Recorta un vector a una longitud mxima.
+	 */
+	sf::Vector2f truncate(const sf::Vector2f& vector, float maxLength);
+
+	/**
+	 * @brief Ir hacia un punto a velocidad mxima.
+	 */
+	sf::Vector2f seek(const sf::Vector2f& position, const sf::Vector2f& velocity,
+	                  const sf::Vector2f& target, float maxSpeed);
+
+	/**
+	 * @brief Alejarse de un punto; no hace nada ms all de `panicDistance`.
+	 */
+	sf::Vector2f flee(const sf::Vector2f& position, const sf::Vector2f& velocity,
+	                  const sf::Vector2f& threat, float maxSpeed, float panicDistance);
+
+	/**
+	 * @brief Ir hacia un punto frenando dentro de `slowingRadius`.
+	 */
+	sf::Vector2f arrive(const sf::Vector2f& position, const sf::Vector2f& velocity,
+	                    const sf::Vector2f& target, float maxSpeed, float slowingRadius);
+
+	/**
+	 * @brief Ir hacia donde estar otro agente si sigue con la misma velocidad.
+	 */
+	sf::Vector2f pursue(const sf::Vector2f& position, const sf::Vector2f& velocity,
+	                    const sf::Vector2f& quarryPosition, const sf::Vector2f& quarryVelocity, float maxSpeed);
+
+	/**
+	 * @brief Alejarse de donde estar otro agente; no hace nada ms all de `panicDistance`.
+	 */
+	sf::Vector2f evade(const sf::Vector2f& position, const sf::Vector2f& velocity,
+	                   const sf::Vector2f& threatPosition, const sf::Vector2f& threatVelocity,
+	                   float maxSpeed, float panicDistance);
+
+	/**
+	 * @brief Deambular: seguir un punto que se mueve al azar sobre un crculo por delante.
+	 * @param state Estado del agente; se actualiza.
+	 * @param deltaTime Tiempo del paso, para que el giro no dependa de los fotogramas.
+	 */
+	sf::Vector2f wander(const sf::Vector2f& velocity, WanderState& state,
+	                    const SteeringParams& params, float deltaTime);
+}
+
+/**
+ * @class SteeringGroup
+ * @brief Grupo de agentes que mezcla comportamientos, incluidos los de bandada.
+ *
+ * Guarda el estado de los agentes en arreglos SoA. En cada `update` reconstruye una
+ * `UniformGrid` con las posiciones y, con ella, cada agente encuentra a sus vecinos
+ * sin recorrer a todos los dems. Despus calcula en paralelo la fuerza de cada
+ * agente e integra su movimiento.
+ *
+ * Todos los agentes leen las posiciones y velocidades del paso anterior y escriben en
+ * arreglos aparte, as que el resultado no depende del orden ni del nmero de hilos.
+ */
+class SteeringGroup {
+public:
+	/**
+	 * @brief Constructor; usa los parmetros predeterminados.
+	 */
+	SteeringGroup() { setParams(m_params); }
+
+	/**
+	 * @brief Agrega un agente.
+	 * @return ndice del agente en el grupo.
+	 */
+	std::size_t addAgent(const sf::Vector2f& position, const sf::Vector2f& velocity = sf::Vector2f());
+
+	/**
+	 * @brief Elimina todos los agentes.
+	 */
+	void clear();
+
+	std::size_t size() const { return m_positionX.size(); }
+
+	void setParams(const SteeringParams& params);
+	const SteeringParams& getParams() const { return m_params; }
+
+	void setWeights(const SteeringWeights& weights) { m_weights = weights; }
+	const SteeringWeights& getWeights() const { return m_weights; }
+
+	/**
+	 * @brief Punto al que van Seek y Arrive.
+	 */
+	void setTarget(const sf::Vector2f& target) { m_target = target; }
+
+	/**
+	 * @brief Agente que persigue Pursue.
+	 */
+	void setQuarry(const sf::Vector2f& position, const sf::Vector2f& velocity);
+
+	/**
+	 * @brief Amenaza de la que se alejan Flee y Evade.
+	 */
+	void setThreat(const sf::Vector2f& position, const sf::Vector2f& velocity);
+
+	/**
+	 * @brief Avanza la simulacin un paso.
+	 * @param deltaTime Tiempo del paso, en segundos.
+	 */
+	void update(float deltaTime);
+
+	sf::Vector2f getPosition(std::size_t index) const { return sf::Vector2f(m_positionX[index], m_positionY[index]); }
+	sf::Vector2f getVelocity(std::size_t index) const { return sf::Vector2f(m_velocityX[index], m_velocityY[index]); }
+
+	const float* getPositionsX() const { return m_positionX.data(); }
+	const float* getPositionsY() const { return m_positionY.data(); }
+
+	/**
+	 * @brief Rejilla de vecinos del ltimo `update`.
+	 */
+	const UniformGrid& getGrid() const { return m_grid; }
+
+private:
+	/**
+	 * @brief Suma con pesos los comportamientos de un agente, recortada a `maxForce`.
+	 */
+	sf::Vector2f steer(std::size_t index, float deltaTime);
+
+	SteeringParams m_params;   ///< Lmites y distancias.
+	SteeringWeights m_weights; ///< Pesos de la mezcla.
+	sf::Vector2f m_target;     ///< Objetivo de Seek y Arrive.
+	sf::Vector2f m_quarryPosition, m_quarryVelocity; ///< Agente que se persigue.
+	sf::Vector2f m_threatPosition, m_threatVelocity; ///< Amenaza de la que se huye.
+
+	std::vector<float> m_positionX, m_positionY;         ///< Posiciones.
+	std::vector<float> m_velocityX, m_velocityY;         ///< Velocidades.
+	std::vector<float> m_nextPositionX, m_nextPositionY; ///< Posiciones del paso en curso.
+	std::vector<float> m_nextVelocityX, m_nextVelocityY; ///< Velocidades del paso en curso.
+	std::vector<WanderState> m_wander;                   ///< Estado de Wander por agente.
+	UniformGrid m_grid;                                  ///< Vecinos por posicin.
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include "Prerequisites.h"
+
+class ShapeFactory;
+
+/**
+ * @struct SteeringStreams
+ * @brief Arreglos SoA de un lote de agentes: posicin, objetivo y velocidad mxima.
+ *
+ * Cada arreglo tiene `count` elementos y el agente i est en la posicin i de todos.
+ * No hace falta que estn alineados.
+ */
+struct SteeringStreams {
+	float* positionX = nullptr;      ///< Posicin X; se escribe.
+	float* positionY = nullptr;      ///< Posicin Y; se escribe.
+	const float* targetX = nullptr;  ///< Objetivo X.
+	const float* targetY = nullptr;  ///< Objetivo Y.
+	const float* maxSpeed = nullptr; ///< Velocidad mxima, en unidades por segundo.
+	std::size_t count = 0;           ///< Nmero de agentes.
+
+	/**
+	 * @brief Obtiene los arreglos del subrango [begin, end).
+	 */
+	SteeringStreams slice(std::size_t begin, std::size_t end) const {
+		SteeringStreams part;
+		part.positionX = positionX + begin;
+		part.positionY = positionY + begin;
+		part.targetX = targetX + begin;
+		part.targetY = targetY + begin;
+		part.maxSpeed = maxSpeed + begin;
+		part.count = end - begin;
+		return part;
+	}
+};
+
+/**
+ * @brief Kernels de steering por lotes sobre arreglos SoA.
+ *
+ * Procesan ocho agentes por instruccin con AVX, cuatro con SSE2 o uno a la vez, segn
+ * con qu se compile (`/arch:AVX` o `-mavx` activa AVX). El resto que no llena un
+ * registro se procesa con el mismo cdigo escalar, as que el resultado no depende del
+ * camino usado. Las versiones `parallel*` reparten el lote en el `JobSystem`.
+ */
+namespace SteeringKernels {
+	/**
+	 * @brief Nmero de agentes que procesa cada instruccin en esta compilacin (8, 4 o 1).
+	 */
+	std::size_t simdWidth();
+
+	/**
+	 * @brief Mueve cada agente hacia su objetivo a velocidad mxima.
+	 * @param streams Arreglos del lote.
+	 * @param deltaTime Tiempo del paso.
+	 * @param range Distancia a la que el agente ya no se mueve.
+	 *
+	 * Es lo mismo que `ShapeFactory::Seek` por agente.
+	 */
+	void seekBatch(const SteeringStreams& streams, float deltaTime, float range);
+
+	/**
+	 * @brief Mueve cada agente hacia su objetivo frenando al acercarse.
+	 * @param streams Arreglos del lote.
+	 * @param deltaTime Tiempo del paso.
+	 * @param slowingRadius Distancia desde la que la velocidad baja linealmente hasta cero;
+	 *        0 o menos para no frenar, como `Steering::arrive`.
+	 * @param range Distancia a la que el agente ya no se mueve.
+	 *
+	 * Un agente nunca pasa de largo su objetivo.
+	 */
+	void arriveBatch(const SteeringStreams& streams, float deltaTime, float slowingRadius, float range);
+
+	/**
+	 * @brief `seekBatch` repartido en bloques entre los hilos del `JobSystem`.
+	 */
+	void parallelSeek(const SteeringStreams& streams, float deltaTime, float range);
+
+	/**
+	 * @brief `arriveBatch` repartido en bloques entre los hilos del `JobSystem`.
+	 */
+	void parallelArrive(const SteeringStreams& streams, float deltaTime, float slowingRadius, float range);
+
+	/**
+	 * @brief Copia las posiciones de varias formas a arreglos SoA.
+	 * @param shapes Formas; ninguna puede ser nullptr.
+	 * @param count Nmero de formas.
+	 * @param positionX Destino de X.
+	 * @param positionY Destino de Y.
+	 */
+	void gatherPositions(ShapeFactory* const* shapes, std::size_t count, float* positionX, float* positionY);
+
+	/**
+	 * @brief Escribe de vuelta en las formas las posiciones de arreglos SoA.
+	 * @param shapes Formas; ninguna puede ser nullptr.
+	 * @param count Nmero de formas.
+	 * @param positionX Posiciones X.
+	 * @param positionY Posiciones Y.
+	 *
+	 * Primero escribe todas las transformaciones y despus actualiza el ndice espacial
+	 * de todas las formas en una sola pasada. El ndice se comparte entre las formas, as
+	 * que debe llamarse desde un solo hilo, nunca dentro de un `parallelFor`.
+	 */
+	void scatterPositions(ShapeFactory* const* shapes, std::size_t count, const float* positionX, const float* positionY);
+}
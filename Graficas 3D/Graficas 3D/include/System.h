@@ -0,0 +1,91 @@
+#pragma once
+#include "Prerequisites.h"
+#include "ComponentTypeID.h"
+
+class World;
+
+/**
+ * @class System
+ * @brief Clase base para la lgica que se ejecuta cada fotograma.
+ *
+ * Cada sistema declara qu tipos de componente lee y cules escribe. Con esa
+ * informacin el `SystemScheduler` decide qu sistemas pueden ejecutarse al mismo
+ * tiempo: dos sistemas entran en conflicto si alguno escribe un tipo que el otro
+ * lee o escribe.
+ *
+ * Los tipos se identifican con `ComponentTypeID`, as que sirven tanto los componentes
+ * de datos del World como los componentes polimrficos (`ShapeFactory`, por ejemplo).
+ *
+ * Un sistema no debe agregar ni quitar componentes ni entidades dentro de `update`,
+ * porque otros sistemas pueden estar recorriendo el World en paralelo. Esos cambios se
+ * graban en un `CommandQueue` y se aplican despus de que terminan todos los sistemas.
+ */
+class System {
+public:
+    /**
+     * @brief Destructor virtual.
+     */
+    virtual ~System() = default;
+
+    /**
+     * @brief Ejecuta la lgica del sistema para un fotograma.
+     * @param world World de la aplicacin.
+     * @param deltaTime Tiempo transcurrido desde el ltimo fotograma, en segundos.
+     */
+    virtual void update(World& world, float deltaTime) = 0;
+
+    /**
+     * @brief Indica si este sistema no puede ejecutarse a la vez que otro.
+     * @param other Otro sistema.
+     * @return true si alguno escribe un tipo que el otro lee o escribe.
+     */
+    bool conflictsWith(const System& other) const {
+        return (m_writes & (other.m_reads | other.m_writes)) != 0
+            || (other.m_writes & m_reads) != 0;
+    }
+
+    ComponentMask getReads() const { return m_reads; }
+    ComponentMask getWrites() const { return m_writes; }
+    const std::string& getName() const { return m_name; }
+
+    /**
+     * @brief Posicin del sistema en el orden de registro del scheduler.
+     *
+     * Es estable entre fotogramas, as que sirve como clave de orden para los comandos
+     * que el sistema graba en un `CommandQueue`.
+     */
+    std::uint32_t getOrder() const { return m_order; }
+
+protected:
+    /**
+     * @brief Constructor.
+     * @param name Nombre del sistema, usado en mensajes de diagnstico.
+     */
+    explicit System(std::string name) : m_name(std::move(name)) {}
+
+    /**
+     * @brief Declara tipos de componente que el sistema lee.
+     * @tparam Ts Tipos de componente.
+     */
+    template<typename... Ts>
+    void reads() {
+        m_reads |= (ComponentMask(0) | ... | ComponentBit<Ts>());
+    }
+
+    /**
+     * @brief Declara tipos de componente que el sistema escribe.
+     * @tparam Ts Tipos de componente.
+     */
+    template<typename... Ts>
+    void writes() {
+        m_writes |= (ComponentMask(0) | ... | ComponentBit<Ts>());
+    }
+
+private:
+    friend class SystemScheduler;
+
+    std::string m_name;         ///< Nombre del sistema.
+    std::uint32_t m_order = 0;  ///< Posicin en el orden de registro.
+    ComponentMask m_reads = 0;  ///< Tipos que el sistema lee.
+    ComponentMask m_writes = 0; ///< Tipos que el sistema escribe.
+};
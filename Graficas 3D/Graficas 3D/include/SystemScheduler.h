@@ -0,0 +1,80 @@
+#pragma once
+#include "Prerequisites.h"
+#include "System.h"
+#include "JobSystem.h"
+
+class World;
+
+/**
+ * @class SystemScheduler
+ * @brief Ejecuta los sistemas registrados, en paralelo cuando no entran en conflicto.
+ *
+ * En cada fotograma se construye un grafo de dependencias: un sistema depende de cada
+ * sistema registrado antes que l con el que entra en conflicto. As el resultado es el
+ * mismo que ejecutarlos en orden de registro, pero los sistemas independientes se
+ * reparten entre varios hilos.
+ *
+ * Cada sistema se lanza como trabajo del `JobSystem` en cuanto terminan todos los
+ * sistemas de los que depende.
+ */
+class SystemScheduler {
+public:
+    SystemScheduler() = default;
+    ~SystemScheduler() = default;
+
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    /**
+     * @brief Crea y registra un sistema.
+     * @tparam T Tipo del sistema, debe derivar de System.
+     * @param args Argumentos para el constructor del sistema.
+     * @return Puntero al sistema; el scheduler es su dueo.
+     */
+    template<typename T, typename... Args>
+    T* addSystem(Args&&... args) {
+        static_assert(std::is_base_of<System, T>::value, "T must be derived from System");
+        T* system = new T(std::forward<Args>(args)...);
+        system->m_order = static_cast<std::uint32_t>(m_systems.size());
+        m_systems.push_back(EngineUtilities::TUniquePtr<System>(system));
+        return system;
+    }
+
+    /**
+     * @brief Ejecuta todos los sistemas para un fotograma.
+     * @param world World de la aplicacin.
+     * @param deltaTime Tiempo transcurrido desde el ltimo fotograma, en segundos.
+     */
+    void update(World& world, float deltaTime);
+
+    /**
+     * @brief Destruye todos los sistemas.
+     */
+    void clear();
+
+    std::size_t systemCount() const { return m_systems.size(); }
+
+    /**
+     * @brief Longitud de la cadena de dependencias ms larga del ltimo fotograma.
+     *
+     * Si es igual a `systemCount()`, todo se ejecut en serie.
+     */
+    std::size_t lastCriticalPath() const { return m_criticalPath; }
+
+private:
+    /**
+     * @brief Construye el grafo de dependencias entre los sistemas.
+     */
+    void buildGraph();
+
+    /**
+     * @brief Programa un sistema y, al terminar, los que dependen de l y ya no esperan a otro.
+     */
+    void scheduleSystem(std::size_t index, World& world, float deltaTime, JobCounter& counter);
+
+    std::vector<EngineUtilities::TUniquePtr<System>> m_systems; ///< Sistemas en orden de registro.
+    std::vector<std::vector<std::size_t>> m_dependents;         ///< Sistemas que dependen de cada uno.
+    std::vector<std::uint32_t> m_dependencyCount;               ///< Dependencias de cada sistema.
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_remaining;  ///< Dependencias pendientes en el fotograma.
+    std::size_t m_criticalPath = 0;                             ///< Cadena de dependencias ms larga.
+};
@@ -0,0 +1,179 @@
+#pragma once
+#include "Prerequisites.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @class UniformGrid
+ * @brief Rejilla uniforme de puntos para bsquedas de vecinos.
+ *
+ * Se reconstruye completa en cada `build` a partir de arreglos SoA de posiciones. La
+ * rejilla cubre la caja de los puntos con celdas de `getCellSize()` de lado, y los
+ * puntos se ordenan por celda con un ordenamiento por conteo repartido en el
+ * `JobSystem`: cada bloque de puntos cuenta sus celdas, una suma prefija da dnde
+ * escribe cada bloque y luego todos escriben a la vez sin competir. Dentro de una
+ * celda los puntos quedan en orden de ndice, as que el resultado de las consultas
+ * no depende de cmo se reparti el trabajo.
+ *
+ * Las posiciones se copian en orden de celda, de modo que una consulta recorre memoria
+ * contigua. Si los puntos estn tan dispersos que haran falta demasiadas celdas, el
+ * lado de la celda se duplica hasta que caben; las consultas siguen siendo exactas.
+ * Los puntos con una coordenada NaN o infinita no cuentan para la caja y ninguna
+ * consulta los reporta.
+ */
+class UniformGrid {
+public:
+	/**
+	 * @brief Punto encontrado por `queryNearest`.
+	 */
+	struct Neighbour {
+		std::uint32_t index;   ///< ndice del punto.
+		float distanceSquared; ///< Distancia al cuadrado al centro de la bsqueda.
+	};
+
+	/**
+	 * @brief Constructor.
+	 * @param cellSize Lado de las celdas; conviene que sea parecido al radio de las consultas.
+	 */
+	explicit UniformGrid(float cellSize = 32.0f);
+
+	/**
+	 * @brief Cambia el lado de las celdas; se aplica en el siguiente `build`.
+	 */
+	void setCellSize(float cellSize);
+
+	/**
+	 * @brief Lado de celda pedido.
+	 */
+	float getCellSize() const { return m_cellSize; }
+
+	/**
+	 * @brief Reconstruye la rejilla.
+	 * @param positionX Posiciones X de los puntos.
+	 * @param positionY Posiciones Y de los puntos.
+	 * @param count Nmero de puntos; el punto i se reporta con el ndice i.
+	 */
+	void build(const float* positionX, const float* positionY, std::size_t count);
+
+	/**
+	 * @brief Recorre los puntos a distancia `radius` o menos de un centro.
+	 * @param center Centro de la bsqueda.
+	 * @param radius Radio de la bsqueda.
+	 * @param function Funcin `(std::uint32_t index, float distanceSquared)` llamada por cada punto.
+	 *
+	 * Es de solo lectura, as que varios hilos pueden consultar a la vez.
+	 */
+	template<typename Function>
+	void queryRadius(const sf::Vector2f& center, float radius, Function&& function) const {
+		int minColumn, minRow, maxColumn, maxRow;
+		if (!cellRange(center, radius, minColumn, minRow, maxColumn, maxRow)) {
+			return;
+		}
+
+		const float radiusSquared = radius * radius;
+		for (int row = minRow; row <= maxRow; ++row) {
+			const std::size_t rowStart = static_cast<std::size_t>(row) * m_columns;
+			const std::uint32_t begin = m_cellStart[rowStart + minColumn];
+			const std::uint32_t end = m_cellStart[rowStart + maxColumn + 1];
+			// Las celdas de una fila son contiguas en el orden, as que se recorren de una vez.
+			for (std::uint32_t k = begin; k < end; ++k) {
+				const float dx = m_sortedX[k] - center.x;
+				const float dy = m_sortedY[k] - center.y;
+				const float distanceSquared = dx * dx + dy * dy;
+				if (distanceSquared <= radiusSquared) {
+					function(m_indices[k], distanceSquared);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Busca los `k` puntos ms cercanos a un centro.
+	 * @param center Centro de la bsqueda.
+	 * @param k Nmero de puntos a buscar.
+	 * @param out Vector donde se dejan, del ms cercano al ms lejano; se vaca antes.
+	 */
+	void queryNearest(const sf::Vector2f& center, std::size_t k, std::vector<Neighbour>& out) const;
+
+	/**
+	 * @brief Recorre cada par de puntos a distancia `radius` o menos, una sola vez por par.
+	 * @param radius Distancia mxima.
+	 * @param function Funcin `(std::uint32_t a, std::uint32_t b, float distanceSquared)`, con a < b.
+	 *
+	 * Sirve como fase amplia de colisiones: los pares de puntos cercanos se encuentran
+	 * sin comparar todos contra todos.
+	 */
+	template<typename Function>
+	void forEachPair(float radius, Function&& function) const {
+		for (std::size_t k = 0; k < m_indices.size(); ++k) {
+			const std::uint32_t a = m_indices[k];
+			queryRadius(sf::Vector2f(m_sortedX[k], m_sortedY[k]), radius,
+				[a, &function](std::uint32_t b, float distanceSquared) {
+					if (a < b) {
+						function(a, b, distanceSquared);
+					}
+				});
+		}
+	}
+
+	/**
+	 * @brief Nmero de puntos del ltimo `build`.
+	 */
+	std::size_t size() const { return m_indices.size(); }
+
+	/**
+	 * @brief Nmero de celdas del ltimo `build`.
+	 */
+	std::size_t cellCount() const { return static_cast<std::size_t>(m_columns) * m_rows; }
+
+private:
+	/**
+	 * @brief Caja de los puntos de un bloque.
+	 */
+	struct Bounds {
+		float minX, minY, maxX, maxY;
+	};
+
+	/**
+	 * @brief Calcula las celdas que toca la caja de un crculo, recortadas a la rejilla.
+	 * @return false si la caja no toca la rejilla o si el centro o el radio son NaN.
+	 *
+	 * Recorta en float antes de convertir a int, as que un centro lejano o un radio
+	 * infinito no se salen del rango de int.
+	 */
+	bool cellRange(const sf::Vector2f& center, float radius,
+	               int& minColumn, int& minRow, int& maxColumn, int& maxRow) const {
+		if (m_indices.empty()) {
+			return false;
+		}
+		const float left = (center.x - radius - m_originX) * m_invCellSize;
+		const float top = (center.y - radius - m_originY) * m_invCellSize;
+		const float right = (center.x + radius - m_originX) * m_invCellSize;
+		const float bottom = (center.y + radius - m_originY) * m_invCellSize;
+		// Escrito en positivo para que un NaN, que falla toda comparacin, tambin salga.
+		if (!(right >= 0.0f && bottom >= 0.0f && left < m_columns && top < m_rows)) {
+			return false;
+		}
+		minColumn = static_cast<int>(std::max(left, 0.0f));
+		minRow = static_cast<int>(std::max(top, 0.0f));
+		maxColumn = static_cast<int>(std::min(right, static_cast<float>(m_columns - 1)));
+		maxRow = static_cast<int>(std::min(bottom, static_cast<float>(m_rows - 1)));
+		return true;
+	}
+
+	float m_cellSize;            ///< Lado de celda pedido.
+	float m_invCellSize = 0.0f;  ///< 1 / lado de celda usado en el ltimo `build`.
+	float m_originX = 0.0f;      ///< Esquina superior izquierda de la rejilla.
+	float m_originY = 0.0f;
+	int m_columns = 0;           ///< Celdas por fila.
+	int m_rows = 0;              ///< Celdas por columna.
+
+	std::vector<std::uint32_t> m_cellStart;   ///< Primer punto de cada celda en el orden; una entrada extra al final.
+	std::vector<std::uint32_t> m_indices;     ///< ndices de los puntos, ordenados por celda.
+	std::vector<float> m_sortedX;             ///< Posiciones X en el mismo orden.
+	std::vector<float> m_sortedY;             ///< Posiciones Y en el mismo orden.
+	std::vector<std::uint32_t> m_pointCell;   ///< Celda de cada punto, en orden de ndice.
+	std::vector<std::uint32_t> m_chunkCounts; ///< Conteo por bloque y celda; luego, dnde escribe cada bloque.
+	std::vector<Bounds> m_chunkBounds;        ///< Caja de cada bloque.
+};
@@ -1,5 +1,16 @@
 #pragma once
 #include "Prerequisites.h"
+#include "RenderQueue.h"
+#include "SoftwareRasterizer.h"
+
+/**
+ * @enum WindowBackend
+ * @brief Define dnde dibuja una ventana.
+ */
+enum WindowBackend {
+	RENDER_WINDOW = 0, ///< Ventana de SFML, dibujada por la GPU.
+	SOFTWARE = 1       ///< Framebuffer en memoria, rasterizado por la CPU; no abre ventana.
+};
 
 /**
  * @class Window
@@ -8,6 +19,10 @@
  * `Window` gestiona la creacin, actualizacin y renderizado de una ventana
  * utilizando la biblioteca SFML. Permite manejar eventos de entrada y
  * dibujar objetos en la ventana.
+ *
+ * Con el backend `SOFTWARE` no se abre ninguna ventana: lo encolado se rasteriza
+ * en la CPU sobre un framebuffer en memoria (`SoftwareRasterizer`), lo que permite
+ * renderizar en mquinas sin GPU ni pantalla y guardar los fotogramas como imagen.
  */
 class Window {
 public:
@@ -23,11 +38,12 @@ public:
 	 * @param width Ancho de la ventana.
 	 * @param height Alto de la ventana.
 	 * @param title Ttulo de la ventana.
+	 * @param backend Dnde dibuja la ventana.
 	 *
 	 * Este constructor establece las dimensiones y el ttulo de la ventana
 	 * al momento de su creacin.
 	 */
-	Window(int width, int height, const std::string& title);
+	Window(int width, int height, const std::string& title, WindowBackend backend = RENDER_WINDOW);
 
 	/**
 	 * @brief Destructor.
@@ -70,6 +86,16 @@ public:
 	 */
 	bool isOpen() const;
 
+	/**
+	 * @brief Cierra la ventana; `isOpen` devuelve false desde entonces.
+	 */
+	void close();
+
+	/**
+	 * @brief Indica si la ventana usa el backend por CPU, sin ventana real.
+	 */
+	bool isHeadless() const { return m_backend == SOFTWARE; }
+
 	/**
 	 * @brief Dibuja un objeto que puede ser dibujado en la ventana.
 	 * @param drawable Referencia a un objeto SFML que puede ser dibujado.
@@ -79,6 +105,51 @@ public:
 	 */
 	void draw(const sf::Drawable& drawable);
 
+	/**
+	 * @brief Encola una forma para dibujarse en lote.
+	 * @param shape Forma a dibujar.
+	 * @param order Capa, profundidad y modo de mezcla.
+	 *
+	 * Las formas encoladas se ordenan por capa y estado y se dibujan juntas en
+	 * `display`, con una llamada de dibujo por lote en lugar de una por forma.
+	 */
+	void submit(const sf::Shape& shape, const DrawOrder& order = DrawOrder());
+
+	/**
+	 * @brief Encola una copia de una geometra compartida para dibujarse en lote.
+	 * @param mesh Geometra en espacio local.
+	 * @param transform Transformacin de la copia.
+	 * @param color Color de relleno de la copia.
+	 * @param order Capa, profundidad y modo de mezcla.
+	 */
+	void submit(const ShapeMesh& mesh, const sf::Transform& transform, const sf::Color& color,
+	            const DrawOrder& order = DrawOrder());
+
+	/**
+	 * @brief Obtiene el rectngulo de mundo que cubre la vista actual.
+	 * @return La caja de la vista; si la vista est rotada, la caja que la contiene.
+	 *
+	 * Sirve para descartar antes de enviarlos los objetos que no se ven.
+	 */
+	sf::FloatRect getViewBounds() const;
+
+	/**
+	 * @brief Guarda como imagen lo que se mostr en el ltimo `display`.
+	 * @param path Ruta del archivo; el formato sale de la extensin.
+	 * @return true si se guard.
+	 */
+	bool saveFrame(const std::string& path);
+
+	/**
+	 * @brief Obtiene el rasterizador por CPU (solo tiene contenido con el backend `SOFTWARE`).
+	 */
+	SoftwareRasterizer& getRasterizer() { return m_rasterizer; }
+
+	/**
+	 * @brief Obtiene la cola de dibujo en lote de la ventana.
+	 */
+	RenderQueue& getRenderQueue() { return m_renderQueue; }
+
 	/**
 	 * @brief Obtiene el objeto interno SFML RenderWindow.
 	 *
@@ -122,5 +193,9 @@ public:
 	void destroy();
 
 private:
-	sf::RenderWindow* m_window; ///< Puntero al objeto interno SFML RenderWindow.
+	sf::RenderWindow* m_window = nullptr; ///< Puntero al objeto interno SFML RenderWindow.
+	RenderQueue m_renderQueue;           ///< Formas pendientes de dibujarse en lote.
+	WindowBackend m_backend = RENDER_WINDOW; ///< Dnde dibuja la ventana.
+	SoftwareRasterizer m_rasterizer;     ///< Framebuffer del backend `SOFTWARE`.
+	bool m_headlessOpen = false;         ///< Si la ventana `SOFTWARE` sigue abierta.
 };
@@ -0,0 +1,266 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Archetype.h"
+#include <algorithm>
+#include <unordered_map>
+
+/**
+ * @struct EntityRecord
+ * @brief Ubicacin de una entidad del World dentro de su arquetipo.
+ */
+struct EntityRecord {
+    Archetype* archetype = nullptr; ///< Arquetipo que guarda los componentes de la entidad.
+    Archetype::Row row;             ///< Fila dentro del arquetipo.
+};
+
+/**
+ * @class World
+ * @brief Contenedor de entidades con almacenamiento por arquetipos.
+ *
+ * A diferencia de `Entity`, que guarda punteros a componentes polimrficos, el World
+ * guarda componentes de datos (structs simples) agrupados por arquetipo: todas las entidades
+ * con el mismo conjunto de componentes comparten chunks con disposicin SoA. Las consultas
+ * `each` y `eachChunk` recorren esos chunks de forma lineal, por lo que el coste de recorrer
+ * 100k entidades es el de recorrer unos cuantos arreglos contiguos.
+ *
+ * Las entidades se identifican con `EntityHandle`; un handle de una entidad destruida deja de
+ * ser vlido aunque su espacio se reutilice.
+ *
+ * Agregar o quitar componentes mueve la entidad a otro arquetipo, as que no se debe hacer
+ * mientras se recorre una consulta.
+ */
+class World {
+public:
+    World() = default;
+    ~World() = default;
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /**
+     * @brief Crea una entidad con los componentes dados.
+     * @tparam Ts Tipos de los componentes; no se pueden repetir.
+     * @param components Valores iniciales de los componentes.
+     * @return Handle de la nueva entidad.
+     */
+    template<typename... Ts>
+    EntityHandle createEntity(Ts... components) {
+        const ComponentMask mask = (ComponentMask(0) | ... | ComponentBit<Ts>());
+        if (countComponentBits(mask) != sizeof...(Ts)) {
+            ERROR("World", "createEntity", "Component types must be unique");
+        }
+
+        Archetype* archetype = findArchetype(mask);
+        if (archetype == nullptr) {
+            archetype = createArchetype({ ComponentColumnInfo::of<Ts>()... });
+        }
+
+        EntityHandle entity = m_entities.create();
+        EntityRecord* record = m_entities.get(entity);
+        record->archetype = archetype;
+        record->row = archetype->allocateRow(entity);
+        (constructComponent<Ts>(*record, std::move(components)), ...);
+        return entity;
+    }
+
+    /**
+     * @brief Destruye una entidad y sus componentes.
+     * @param entity Handle de la entidad.
+     * @return true si la entidad exista.
+     */
+    bool destroyEntity(EntityHandle entity);
+
+    /**
+     * @brief Indica si un handle sigue refirindose a una entidad viva.
+     * @param entity Handle de la entidad.
+     * @return true si la entidad existe.
+     */
+    bool isAlive(EntityHandle entity) const {
+        return m_entities.isValid(entity);
+    }
+
+    /**
+     * @brief Obtiene un componente de una entidad.
+     * @tparam T Tipo del componente.
+     * @param entity Handle de la entidad.
+     * @return Puntero al componente, o nullptr si la entidad no existe o no lo tiene.
+     *
+     * El puntero deja de ser vlido si la entidad cambia de arquetipo o si se destruye
+     * otra entidad del mismo arquetipo.
+     */
+    template<typename T>
+    T* get(EntityHandle entity) {
+        EntityRecord* record = m_entities.get(entity);
+        if (record == nullptr || !(record->archetype->mask() & ComponentBit<T>())) {
+            return nullptr;
+        }
+        Archetype* archetype = record->archetype;
+        return static_cast<T*>(archetype->componentAt(record->row, archetype->columnIndex(ComponentTypeID<T>())));
+    }
+
+    /**
+     * @brief Indica si una entidad tiene un componente.
+     * @tparam T Tipo del componente.
+     * @param entity Handle de la entidad.
+     * @return true si la entidad existe y tiene el componente.
+     */
+    template<typename T>
+    bool has(EntityHandle entity) const {
+        const EntityRecord* record = m_entities.get(entity);
+        return record != nullptr && (record->archetype->mask() & ComponentBit<T>()) != 0;
+    }
+
+    /**
+     * @brief Agrega un componente a una entidad, o reemplaza su valor si ya lo tena.
+     * @tparam T Tipo del componente.
+     * @param entity Handle de la entidad.
+     * @param component Valor del componente.
+     * @return Puntero al componente, o nullptr si la entidad no existe.
+     */
+    template<typename T>
+    T* add(EntityHandle entity, T component) {
+        EntityRecord* record = m_entities.get(entity);
+        if (record == nullptr) {
+            return nullptr;
+        }
+        if (record->archetype->mask() & ComponentBit<T>()) {
+            T* existing = get<T>(entity);
+            *existing = std::move(component);
+            return existing;
+        }
+
+        const ComponentMask mask = record->archetype->mask() | ComponentBit<T>();
+        Archetype* target = findArchetype(mask);
+        if (target == nullptr) {
+            std::vector<ComponentColumnInfo> columns = record->archetype->columns();
+            columns.push_back(ComponentColumnInfo::of<T>());
+            target = createArchetype(std::move(columns));
+        }
+        moveEntity(entity, *record, target);
+        return constructComponent<T>(*record, std::move(component));
+    }
+
+    /**
+     * @brief Quita un componente de una entidad.
+     * @tparam T Tipo del componente.
+     * @param entity Handle de la entidad.
+     * @return true si la entidad tena el componente.
+     */
+    template<typename T>
+    bool remove(EntityHandle entity) {
+        EntityRecord* record = m_entities.get(entity);
+        if (record == nullptr || !(record->archetype->mask() & ComponentBit<T>())) {
+            return false;
+        }
+
+        const ComponentMask mask = record->archetype->mask() & ~ComponentBit<T>();
+        Archetype* target = findArchetype(mask);
+        if (target == nullptr) {
+            std::vector<ComponentColumnInfo> columns;
+            for (const ComponentColumnInfo& column : record->archetype->columns()) {
+                if (column.typeID != ComponentTypeID<T>()) {
+                    columns.push_back(column);
+                }
+            }
+            target = createArchetype(std::move(columns));
+        }
+        moveEntity(entity, *record, target);
+        return true;
+    }
+
+    /**
+     * @brief Recorre por chunks todas las entidades que tienen los componentes Ts.
+     * @tparam Ts Tipos de componente requeridos.
+     * @param function Funcin `(std::uint32_t count, const EntityHandle* entities, Ts*... arrays)`.
+     *
+     * Cada llamada recibe los arreglos contiguos de un chunk. Es la forma ms rpida de
+     * procesar componentes en lote.
+     */
+    template<typename... Ts, typename Function>
+    void eachChunk(Function&& function) {
+        const ComponentMask required = (ComponentMask(0) | ... | ComponentBit<Ts>());
+        for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+            if (!archetype->matches(required)) {
+                continue;
+            }
+            for (std::uint32_t chunk = 0; chunk < archetype->chunkCount(); ++chunk) {
+                function(archetype->chunkSize(chunk),
+                         static_cast<const EntityHandle*>(archetype->entities(chunk)),
+                         archetype->template column<Ts>(chunk)...);
+            }
+        }
+    }
+
+    /**
+     * @brief Recorre todas las entidades que tienen los componentes Ts.
+     * @tparam Ts Tipos de componente requeridos.
+     * @param function Funcin `(Ts&... components)`.
+     */
+    template<typename... Ts, typename Function>
+    void each(Function&& function) {
+        eachChunk<Ts...>([&function](std::uint32_t count, const EntityHandle*, Ts*... arrays) {
+            for (std::uint32_t i = 0; i < count; ++i) {
+                function(arrays[i]...);
+            }
+        });
+    }
+
+    /**
+     * @brief Recorre todas las entidades que tienen los componentes Ts, junto con su handle.
+     * @tparam Ts Tipos de componente requeridos.
+     * @param function Funcin `(EntityHandle entity, Ts&... components)`.
+     */
+    template<typename... Ts, typename Function>
+    void eachEntity(Function&& function) {
+        eachChunk<Ts...>([&function](std::uint32_t count, const EntityHandle* entities, Ts*... arrays) {
+            for (std::uint32_t i = 0; i < count; ++i) {
+                function(entities[i], arrays[i]...);
+            }
+        });
+    }
+
+    /**
+     * @brief Destruye todas las entidades y arquetipos.
+     */
+    void clear();
+
+    std::size_t entityCount() const { return m_entities.size(); }
+    std::size_t archetypeCount() const { return m_archetypes.size(); }
+
+private:
+    /**
+     * @brief Construye un componente en la fila de una entidad.
+     */
+    template<typename T>
+    T* constructComponent(EntityRecord& record, T&& component) {
+        Archetype* archetype = record.archetype;
+        void* memory = archetype->componentAt(record.row, archetype->columnIndex(ComponentTypeID<T>()));
+        return ::new (memory) T(std::move(component));
+    }
+
+    /**
+     * @brief Busca el arquetipo de una mscara.
+     * @return El arquetipo, o nullptr si an no existe.
+     */
+    Archetype* findArchetype(ComponentMask mask) const {
+        auto it = m_archetypeIndex.find(mask);
+        return it != m_archetypeIndex.end() ? it->second : nullptr;
+    }
+
+    /**
+     * @brief Crea el arquetipo de un conjunto de columnas (en cualquier orden).
+     */
+    Archetype* createArchetype(std::vector<ComponentColumnInfo> columns);
+
+    /**
+     * @brief Mueve una entidad a otro arquetipo.
+     *
+     * Los componentes que existen en ambos se mueven; los que no existen en el destino
+     * se destruyen. Los que solo existen en el destino quedan sin construir.
+     */
+    void moveEntity(EntityHandle entity, EntityRecord& record, Archetype* target);
+
+    EngineUtilities::THandleTable<EntityRecord> m_entities;               ///< Ubicacin de cada entidad.
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;                 ///< Arquetipos en orden de creacin.
+    std::unordered_map<ComponentMask, Archetype*> m_archetypeIndex;       ///< Arquetipo por mscara.
+};
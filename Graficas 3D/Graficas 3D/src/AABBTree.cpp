@@ -0,0 +1,311 @@
+#include "AABBTree.h"
+#include <algorithm>
+
+/**
+ * @brief Constructor.
+ * @param margin Cunto se agranda la caja de cada proxy por lado.
+ */
+AABBTree::AABBTree(float margin) : m_margin(margin) {}
+
+/**
+ * @brief Registra un objeto.
+ * @param bounds Caja del objeto.
+ * @param userData Dato asociado que devuelven las consultas.
+ * @return Identificador del proxy.
+ */
+int AABBTree::createProxy(const sf::FloatRect& bounds, void* userData) {
+	const int proxyId = allocateNode();
+	Node& node = m_nodes[proxyId];
+	node.box = toBox(bounds);
+	node.box.min -= sf::Vector2f(m_margin, m_margin);
+	node.box.max += sf::Vector2f(m_margin, m_margin);
+	node.userData = userData;
+	node.height = 0;
+
+	insertLeaf(proxyId);
+	++m_proxyCount;
+	return proxyId;
+}
+
+/**
+ * @brief Elimina un objeto.
+ * @param proxyId Identificador del proxy.
+ */
+void AABBTree::destroyProxy(int proxyId) {
+	removeLeaf(proxyId);
+	freeNode(proxyId);
+	--m_proxyCount;
+}
+
+/**
+ * @brief Actualiza la caja de un objeto.
+ * @param proxyId Identificador del proxy.
+ * @param bounds Nueva caja del objeto.
+ * @return true si la hoja se reinsert; false si la caja gorda todava la contena.
+ */
+bool AABBTree::moveProxy(int proxyId, const sf::FloatRect& bounds) {
+	const Box box = toBox(bounds);
+	if (contains(m_nodes[proxyId].box, box)) {
+		return false;
+	}
+
+	removeLeaf(proxyId);
+	Node& node = m_nodes[proxyId];
+	node.box = box;
+	node.box.min -= sf::Vector2f(m_margin, m_margin);
+	node.box.max += sf::Vector2f(m_margin, m_margin);
+	insertLeaf(proxyId);
+	return true;
+}
+
+/**
+ * @brief Obtiene la caja gorda de un proxy.
+ */
+sf::FloatRect AABBTree::getFatBounds(int proxyId) const {
+	const Box& box = m_nodes[proxyId].box;
+	return sf::FloatRect(box.min.x, box.min.y, box.max.x - box.min.x, box.max.y - box.min.y);
+}
+
+/**
+ * @brief Elimina todos los proxies.
+ */
+void AABBTree::clear() {
+	m_nodes.clear();
+	m_root = NullNode;
+	m_freeList = NullNode;
+	m_proxyCount = 0;
+}
+
+AABBTree::Box AABBTree::toBox(const sf::FloatRect& rect) {
+	Box box;
+	box.min = sf::Vector2f(std::min(rect.left, rect.left + rect.width), std::min(rect.top, rect.top + rect.height));
+	box.max = sf::Vector2f(std::max(rect.left, rect.left + rect.width), std::max(rect.top, rect.top + rect.height));
+	return box;
+}
+
+AABBTree::Box AABBTree::combine(const Box& a, const Box& b) {
+	Box box;
+	box.min = sf::Vector2f(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y));
+	box.max = sf::Vector2f(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y));
+	return box;
+}
+
+float AABBTree::perimeter(const Box& box) {
+	return 2.0f * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+}
+
+bool AABBTree::contains(const Box& outer, const Box& inner) {
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y &&
+		inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+/**
+ * @brief Toma un nodo de la lista de libres, o agrega uno al arreglo.
+ */
+int AABBTree::allocateNode() {
+	if (m_freeList == NullNode) {
+		m_nodes.emplace_back();
+		return static_cast<int>(m_nodes.size() - 1);
+	}
+
+	const int nodeId = m_freeList;
+	m_freeList = m_nodes[nodeId].parent;
+	m_nodes[nodeId] = Node();
+	return nodeId;
+}
+
+/**
+ * @brief Devuelve un nodo a la lista de libres.
+ */
+void AABBTree::freeNode(int nodeId) {
+	m_nodes[nodeId].parent = m_freeList;
+	m_nodes[nodeId].height = -1;
+	m_nodes[nodeId].userData = nullptr;
+	m_freeList = nodeId;
+}
+
+/**
+ * @brief Inserta una hoja junto al hermano que menos agranda el rbol.
+ *
+ * Baja desde la raz comparando el costo de crear un padre nuevo en el nodo actual
+ * contra el costo mnimo de seguir por cada hijo; el costo es el permetro, porque en
+ * 2D es lo que se comporta como el rea de superficie en 3D.
+ */
+void AABBTree::insertLeaf(int leaf) {
+	if (m_root == NullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = NullNode;
+		return;
+	}
+
+	const Box leafBox = m_nodes[leaf].box;
+	int index = m_root;
+	while (!m_nodes[index].isLeaf()) {
+		const Node& node = m_nodes[index];
+		const float area = perimeter(node.box);
+		const float combinedArea = perimeter(combine(node.box, leafBox));
+
+		// Costo de crear un padre para este nodo y la hoja.
+		const float cost = 2.0f * combinedArea;
+		// Costo mnimo de bajar la hoja ms en el rbol.
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](int child) {
+			const Node& childNode = m_nodes[child];
+			const float grown = perimeter(combine(leafBox, childNode.box));
+			if (childNode.isLeaf()) {
+				return grown + inheritanceCost;
+			}
+			return grown - perimeter(childNode.box) + inheritanceCost;
+		};
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+	const int sibling = index;
+
+	// Nuevo padre para el hermano y la hoja.
+	const int oldParent = m_nodes[sibling].parent;
+	const int newParent = allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].box = combine(leafBox, m_nodes[sibling].box);
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if (oldParent == NullNode) {
+		m_root = newParent;
+	}
+	else if (m_nodes[oldParent].child1 == sibling) {
+		m_nodes[oldParent].child1 = newParent;
+	}
+	else {
+		m_nodes[oldParent].child2 = newParent;
+	}
+
+	// Subir arreglando cajas y alturas, y equilibrando.
+	index = m_nodes[leaf].parent;
+	while (index != NullNode) {
+		index = balance(index);
+		Node& node = m_nodes[index];
+		node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+		node.box = combine(m_nodes[node.child1].box, m_nodes[node.child2].box);
+		index = node.parent;
+	}
+}
+
+/**
+ * @brief Saca una hoja del rbol; su hermano ocupa el lugar del padre.
+ */
+void AABBTree::removeLeaf(int leaf) {
+	if (leaf == m_root) {
+		m_root = NullNode;
+		return;
+	}
+
+	const int parent = m_nodes[leaf].parent;
+	const int grandParent = m_nodes[parent].parent;
+	const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	if (grandParent == NullNode) {
+		m_root = sibling;
+		m_nodes[sibling].parent = NullNode;
+		freeNode(parent);
+		return;
+	}
+
+	if (m_nodes[grandParent].child1 == parent) {
+		m_nodes[grandParent].child1 = sibling;
+	}
+	else {
+		m_nodes[grandParent].child2 = sibling;
+	}
+	m_nodes[sibling].parent = grandParent;
+	freeNode(parent);
+
+	int index = grandParent;
+	while (index != NullNode) {
+		index = balance(index);
+		Node& node = m_nodes[index];
+		node.box = combine(m_nodes[node.child1].box, m_nodes[node.child2].box);
+		node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+		index = node.parent;
+	}
+}
+
+/**
+ * @brief Equilibra el subrbol de un nodo con una rotacin si hace falta.
+ * @param nodeId Nodo A, raz del subrbol.
+ * @return El nodo que qued como raz del subrbol.
+ *
+ * Si un hijo (C o B) es ms alto que el otro por ms de uno, sube a ocupar el lugar de
+ * A; A se queda con el nieto ms bajo y el ms alto pasa a ser hijo del que subi.
+ */
+int AABBTree::balance(int nodeId) {
+	const int iA = nodeId;
+	Node& A = m_nodes[iA];
+	if (A.isLeaf() || A.height < 2) {
+		return iA;
+	}
+
+	const int iB = A.child1;
+	const int iC = A.child2;
+	const int heightDiff = m_nodes[iC].height - m_nodes[iB].height;
+
+	// Sube C (o B) y A toma el lugar de uno de sus hijos.
+	auto rotate = [&](int iUp, int iOther, bool upIsChild2) {
+		Node& up = m_nodes[iUp];
+		const int iF = up.child1;
+		const int iG = up.child2;
+
+		up.child1 = iA;
+		up.parent = A.parent;
+		A.parent = iUp;
+
+		if (up.parent != NullNode) {
+			if (m_nodes[up.parent].child1 == iA) {
+				m_nodes[up.parent].child1 = iUp;
+			}
+			else {
+				m_nodes[up.parent].child2 = iUp;
+			}
+		}
+		else {
+			m_root = iUp;
+		}
+
+		// El nieto ms alto se queda bajo `up`; el otro pasa a A.
+		const bool fIsTaller = m_nodes[iF].height > m_nodes[iG].height;
+		const int iTall = fIsTaller ? iF : iG;
+		const int iShort = fIsTaller ? iG : iF;
+
+		up.child2 = iTall;
+		if (upIsChild2) {
+			A.child2 = iShort;
+		}
+		else {
+			A.child1 = iShort;
+		}
+		m_nodes[iShort].parent = iA;
+
+		A.box = combine(m_nodes[iOther].box, m_nodes[iShort].box);
+		up.box = combine(A.box, m_nodes[iTall].box);
+		A.height = 1 + std::max(m_nodes[iOther].height, m_nodes[iShort].height);
+		up.height = 1 + std::max(A.height, m_nodes[iTall].height);
+		return iUp;
+	};
+
+	if (heightDiff > 1) {
+		return rotate(iC, iB, true);
+	}
+	if (heightDiff < -1) {
+		return rotate(iB, iC, false);
+	}
+	return iA;
+}
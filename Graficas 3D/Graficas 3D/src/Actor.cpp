@@ -9,10 +9,10 @@
  */
 Actor::Actor(std::string actorName) {
 	// Setup Actor Name
-	m_name = actorName;
+	m_name = std::move(actorName);
 
 	// Setup Shape
-	EngineUtilities::TSharedPointer<ShapeFactory> shape = EngineUtilities::MakeShared<ShapeFactory>();
+	EngineUtilities::TIntrusivePtr<ShapeFactory> shape = EngineUtilities::MakeIntrusive<ShapeFactory>();
 	addComponent(shape);
 
 	// Setup Transform
@@ -37,22 +37,25 @@ void Actor::update(float deltaTime)
  * @brief Renderiza el actor en la ventana.
  * @param window Contexto del dispositivo para operaciones grficas.
  *
- * Este mtodo recorre todos los componentes del actor y dibuja la forma
- * asociada al componente `ShapeFactory` en la ventana.
+ * Este mtodo dibuja la forma asociada al componente `ShapeFactory` en la ventana.
  */
 void Actor::render(Window& window)
 {
-	for (unsigned int i = 0; i < components.size(); i++) {
-		window.draw(*components[i].dynamic_pointer_cast<ShapeFactory>()->getShape());
+	ShapeFactory* shape = getComponentPtr<ShapeFactory>();
+	if (shape && shape->getMesh()) {
+		window.submit(*shape->getMesh(), shape->getTransform(), shape->getFillColor(), shape->getDrawOrder());
 	}
 }
 
 /**
  * @brief Destruye el actor y libera los recursos asociados.
  *
- * Este mtodo es responsable de liberar los recursos utilizados por el
- * actor. Actualmente, no se ha implementado lgica especfica en este mtodo.
+ * Marca el actor como inactivo y suelta sus componentes; los que nadie ms
+ * referencia se liberan en ese momento. La memoria del actor la libera despus
+ * su `EntityRegistry`.
  */
 void Actor::destroy()
 {
+	isActive = false;
+	removeAllComponents();
 }
@@ -0,0 +1,116 @@
+#include "ActorGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	float cross(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& p) {
+		return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+	}
+
+	/**
+	 * @brief Indica si un punto en espacio local est dentro del relleno de una geometra.
+	 *
+	 * Un punto sobre una arista cuenta como adentro, sin importar el sentido del tringulo.
+	 */
+	bool meshContains(const ShapeMesh& mesh, const sf::Vector2f& point) {
+		if (!mesh.bounds.contains(point)) {
+			return false;
+		}
+		for (std::size_t i = 0; i + 2 < mesh.triangles.size(); i += 3) {
+			const float d0 = cross(mesh.triangles[i], mesh.triangles[i + 1], point);
+			const float d1 = cross(mesh.triangles[i + 1], mesh.triangles[i + 2], point);
+			const float d2 = cross(mesh.triangles[i + 2], mesh.triangles[i], point);
+			const bool hasNegative = d0 < 0.0f || d1 < 0.0f || d2 < 0.0f;
+			const bool hasPositive = d0 > 0.0f || d1 > 0.0f || d2 > 0.0f;
+			if (!(hasNegative && hasPositive)) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+/**
+ * @brief Reconstruye la rejilla con los actores activos que tienen forma.
+ * @param actors Registro de actores.
+ *
+ * Tambin guarda cunto se aleja la caja de cada actor de su posicin, para que
+ * `pick` sepa hasta dnde buscar.
+ */
+void ActorGrid::rebuild(EntityRegistry& actors) {
+	m_actors.clear();
+	m_handles.clear();
+	m_positionX.clear();
+	m_positionY.clear();
+	m_maxExtent = 0.0f;
+
+	actors.forEach([this](ActorHandle handle, Actor& actor) {
+		ShapeFactory* shape = actor.getComponentPtr<ShapeFactory>();
+		if (shape == nullptr || shape->getMesh() == nullptr) return;
+
+		const sf::Vector2f& position = shape->getPosition();
+		const sf::FloatRect bounds = shape->getGlobalBounds();
+		const float extentX = std::max(std::abs(bounds.left - position.x), std::abs(bounds.left + bounds.width - position.x));
+		const float extentY = std::max(std::abs(bounds.top - position.y), std::abs(bounds.top + bounds.height - position.y));
+		m_maxExtent = std::max(m_maxExtent, std::sqrt(extentX * extentX + extentY * extentY));
+
+		m_actors.push_back(&actor);
+		m_handles.push_back(handle);
+		m_positionX.push_back(position.x);
+		m_positionY.push_back(position.y);
+	});
+
+	m_grid.build(m_positionX.data(), m_positionY.data(), m_actors.size());
+}
+
+/**
+ * @brief Busca los actores a distancia `radius` o menos de un punto.
+ */
+void ActorGrid::queryRange(const sf::Vector2f& center, float radius, std::vector<Actor*>& out) const {
+	out.clear();
+	m_grid.queryRadius(center, radius, [this, &out](std::uint32_t index, float) {
+		out.push_back(m_actors[index]);
+	});
+	std::sort(out.begin(), out.end(), [](const Actor* a, const Actor* b) {
+		return a->getId() < b->getId();
+	});
+}
+
+/**
+ * @brief Busca los `k` actores ms cercanos a un punto.
+ */
+void ActorGrid::queryNearest(const sf::Vector2f& center, std::size_t k, std::vector<Actor*>& out) const {
+	std::vector<UniformGrid::Neighbour> nearest;
+	m_grid.queryNearest(center, k, nearest);
+
+	out.clear();
+	for (const UniformGrid::Neighbour& neighbour : nearest) {
+		out.push_back(m_actors[neighbour.index]);
+	}
+}
+
+/**
+ * @brief Busca el actor cuya forma contiene un punto.
+ * @param point Punto en coordenadas de mundo.
+ * @return El de id mayor entre los que lo contienen, o un handle invlido.
+ *
+ * Solo revisa los actores cuya posicin est a `m_maxExtent` o menos del punto; ningn
+ * otro puede contenerlo. La prueba es contra los tringulos de la forma, no contra su
+ * caja, as que las esquinas de la caja de un crculo no cuentan.
+ */
+ActorHandle ActorGrid::pick(const sf::Vector2f& point) const {
+	const Actor* picked = nullptr;
+	ActorHandle pickedHandle;
+	m_grid.queryRadius(point, m_maxExtent, [&](std::uint32_t index, float) {
+		const Actor* actor = m_actors[index];
+		if (picked != nullptr && picked->getId() > actor->getId()) return;
+
+		ShapeFactory* shape = actor->getComponentPtr<ShapeFactory>();
+		const sf::Vector2f local = shape->getTransform().getInverse().transformPoint(point);
+		if (meshContains(*shape->getMesh(), local)) {
+			picked = actor;
+			pickedHandle = m_handles[index];
+		}
+	});
+	return pickedHandle;
+}
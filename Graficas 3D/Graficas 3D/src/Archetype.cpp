@@ -0,0 +1,123 @@
+#include "Archetype.h"
+
+namespace {
+	/**
+	 * @brief Redondea un desplazamiento hacia arriba a la alineacin dada.
+	 */
+	std::size_t alignUp(std::size_t offset, std::size_t align) {
+		return (offset + align - 1) & ~(align - 1);
+	}
+}
+
+/**
+ * @brief Crea un arquetipo para un conjunto de columnas.
+ * @param columns Columnas ordenadas por identificador de tipo.
+ *
+ * Calcula cuntas filas caben en un chunk y el desplazamiento de cada columna,
+ * respetando la alineacin de cada tipo.
+ */
+Archetype::Archetype(std::vector<ComponentColumnInfo> columns)
+	: m_columns(std::move(columns)) {
+	std::size_t rowBytes = sizeof(EntityHandle);
+	for (const ComponentColumnInfo& column : m_columns) {
+		m_mask |= ComponentMask(1) << column.typeID;
+		rowBytes += column.size;
+	}
+
+	m_offsets.resize(m_columns.size());
+	m_capacity = static_cast<std::uint32_t>(CHUNK_BYTES / rowBytes);
+	while (m_capacity > 0) {
+		std::size_t offset = m_capacity * sizeof(EntityHandle);
+		for (std::size_t i = 0; i < m_columns.size(); ++i) {
+			offset = alignUp(offset, m_columns[i].align);
+			m_offsets[i] = offset;
+			offset += m_capacity * m_columns[i].size;
+		}
+		if (offset <= CHUNK_BYTES) {
+			break;
+		}
+		--m_capacity;
+	}
+
+	if (m_capacity == 0) {
+		ERROR("Archetype", "Archetype", "Component set does not fit in a chunk");
+	}
+}
+
+/**
+ * @brief Destruye los componentes que queden y libera los chunks.
+ */
+Archetype::~Archetype() {
+	for (Chunk& chunk : m_chunks) {
+		for (std::size_t i = 0; i < m_columns.size(); ++i) {
+			for (std::uint32_t row = 0; row < chunk.count; ++row) {
+				m_columns[i].destroy(chunk.data + m_offsets[i] + row * m_columns[i].size);
+			}
+		}
+		::operator delete(chunk.data, std::align_val_t(CHUNK_ALIGN));
+	}
+}
+
+/**
+ * @brief Reserva una fila al final del arquetipo.
+ * @param entity Handle de la entidad duea de la fila.
+ * @return Ubicacin de la nueva fila.
+ *
+ * Si el ltimo chunk est lleno se pide uno nuevo.
+ */
+Archetype::Row Archetype::allocateRow(EntityHandle entity) {
+	if (m_chunks.empty() || m_chunks.back().count == m_capacity) {
+		Chunk chunk;
+		chunk.data = static_cast<unsigned char*>(::operator new(CHUNK_BYTES, std::align_val_t(CHUNK_ALIGN)));
+		m_chunks.push_back(chunk);
+	}
+
+	Row row;
+	row.chunk = static_cast<std::uint32_t>(m_chunks.size() - 1);
+	row.row = m_chunks.back().count++;
+	entities(row.chunk)[row.row] = entity;
+	++m_size;
+	return row;
+}
+
+/**
+ * @brief Quita una fila cuyos componentes ya fueron destruidos o movidos.
+ * @param row Fila a quitar.
+ * @return Handle de la entidad que pas a ocupar la fila, o un handle nulo.
+ *
+ * La ltima fila del arquetipo se mueve al hueco para que los chunks sigan compactos.
+ * Si el ltimo chunk queda vaco se libera.
+ */
+EntityHandle Archetype::removeRow(Row row) {
+	Row last;
+	last.chunk = static_cast<std::uint32_t>(m_chunks.size() - 1);
+	last.row = m_chunks.back().count - 1;
+
+	EntityHandle moved;
+	if (last.chunk != row.chunk || last.row != row.row) {
+		for (std::uint32_t i = 0; i < m_columns.size(); ++i) {
+			m_columns[i].moveAndDestroy(componentAt(row, i), componentAt(last, i));
+		}
+		moved = entities(last.chunk)[last.row];
+		entities(row.chunk)[row.row] = moved;
+	}
+
+	--m_size;
+	if (--m_chunks.back().count == 0) {
+		::operator delete(m_chunks.back().data, std::align_val_t(CHUNK_ALIGN));
+		m_chunks.pop_back();
+	}
+	return moved;
+}
+
+/**
+ * @brief Destruye los componentes de una fila y la quita.
+ * @param row Fila a destruir.
+ * @return Handle de la entidad que pas a ocupar la fila, o un handle nulo.
+ */
+EntityHandle Archetype::destroyRow(Row row) {
+	for (std::uint32_t i = 0; i < m_columns.size(); ++i) {
+		m_columns[i].destroy(componentAt(row, i));
+	}
+	return removeRow(row);
+}
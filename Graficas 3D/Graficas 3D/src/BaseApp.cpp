@@ -1,10 +1,27 @@
 #include "BaseApp.h"
 
+namespace {
+	/// Esquinas que recorren los buscadores, en orden.
+	const sf::Vector2f SeekerGoals[] = {
+		{ 740.0f, 40.0f },
+		{ 740.0f, 540.0f },
+		{ 40.0f, 540.0f },
+		{ 40.0f, 40.0f }
+	};
+	constexpr std::size_t SeekerGoalCount = sizeof(SeekerGoals) / sizeof(SeekerGoals[0]);
+}
+
 /**
  * @brief Ejecuta la aplicacin.
  *
  * Este mtodo inicializa la aplicacin, maneja eventos, actualiza el estado y
- * renderiza los objetos en un bucle hasta que la ventana se cierre.
+ * renderiza los objetos en un bucle hasta que la ventana se cierre. Al inicio de
+ * cada iteracin se recupera toda la memoria temporal del fotograma anterior. Los
+ * cambios estructurales grabados durante `update` se aplican antes de renderizar, y al
+ * final se liberan juntos los actores destruidos durante el fotograma.
+ *
+ * Si hay lmite de fotogramas, la ventana se cierra al alcanzarlo; si hay ruta de
+ * fotograma, el ltimo se guarda como imagen antes de limpiar.
  *
  * @return Un valor entero que indica el estado de la ejecucin.
  */
@@ -13,10 +30,22 @@ int BaseApp::run() {
 		ERROR("BaseApp", "run", "Initializes result on a false statemente, check method validations");
 	}
 	while (m_window->isOpen()) {
+		m_frameArena.reset();
+		MEMORY_TRACK_BEGIN_FRAME();
 		m_window->handleEvents();
 		deltaTime = clock.restart();
 		update();
+		m_commands.apply(m_actors);
 		render();
+		m_actors.flushDestroyed();
+
+		if (m_frameLimit > 0 && ++m_frameCount >= m_frameLimit) {
+			m_window->close();
+		}
+	}
+
+	if (!m_framePath.empty() && !m_window->saveFrame(m_framePath)) {
+		ERROR("BaseApp", "run", "Could not save the last frame");
 	}
 
 	cleanup();
@@ -26,106 +55,236 @@ int BaseApp::run() {
 /**
  * @brief Inicializa la ventana y los actores.
  *
- * Este mtodo crea una nueva ventana y establece los actores (Circle y Triangle)
- * junto con sus componentes iniciales.
+ * Este mtodo crea una nueva ventana y establece los actores (Circle, Triangle,
+ * las patrullas, la bandada, los muros y los buscadores) junto con sus componentes
+ * iniciales, y la rejilla de navegacin a partir de los muros.
  *
  * @return true si la inicializacin es exitosa, false en caso contrario.
  */
 bool BaseApp::initialize() {
-	m_window = new Window(800, 600, "Galvan Engine");
+	m_window = new Window(800, 600, "Galvan Engine", m_backend);
 	if (!m_window) {
 		ERROR("BaseApp", "initialize", "Error on window creation, var is null");
 		return false;
 	}
 
-	// Triangle Actor
-	Circle = EngineUtilities::MakeShared<Actor>("Circle");
-	if (!Circle.isNull()) {
-		Circle->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
-		Circle->getComponent<ShapeFactory>()->setPosition(200.0f, 200.0f);
-		Circle->getComponent<ShapeFactory>()->setFillColor(sf::Color::Blue);
+	// Circle Actor
+	Circle = m_actors.createEntity("Circle");
+	if (Actor* circle = m_actors.get(Circle)) {
+		circle->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+		circle->getComponent<ShapeFactory>()->setPosition(200.0f, 200.0f);
+		circle->getComponent<ShapeFactory>()->setFillColor(sf::Color::Blue);
+	}
+
+	// Recorrido compartido: el crculo y las patrullas lo recorren a distintas distancias.
+	PathAssetPtr patrolPath = EngineUtilities::MakeShared<PathAsset>(std::vector<sf::Vector2f>{
+		{100.0f, 100.0f},
+		{400.0f, 100.0f},
+		{400.0f, 400.0f},
+		{100.0f, 400.0f}
+	}, true);
+	if (Actor* circle = m_actors.get(Circle)) {
+		circle->getComponent<ShapeFactory>()->setPosition(patrolPath->sample(0.0f));
+		circle->addComponent(EngineUtilities::MakeIntrusive<PathFollow>(patrolPath, 200.0f));
+	}
+
+	// Patrullas: crculos rojos repartidos a lo largo del mismo recorrido.
+	m_actors.createEntities(8, "Patrol", m_patrols);
+	for (std::size_t i = 0; i < m_patrols.size(); ++i) {
+		if (Actor* patrol = m_actors.get(m_patrols[i])) {
+			const float startDistance = patrolPath->getLength() * (i + 1) / (m_patrols.size() + 1);
+			patrol->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+			patrol->getComponent<ShapeFactory>()->setPosition(patrolPath->sample(startDistance));
+			patrol->getComponent<ShapeFactory>()->setFillColor(sf::Color::Red);
+			patrol->addComponent(EngineUtilities::MakeIntrusive<PathFollow>(patrolPath, 120.0f, startDistance));
+		}
+	}
+
+	// Triangle Actor: persigue el mouse (sin ventana real, el centro).
+	Triangle = m_actors.createEntity("Triangle");
+	if (Actor* triangle = m_actors.get(Triangle)) {
+		triangle->getComponent<ShapeFactory>()->createShape(ShapeType::TRIANGLE);
+		triangle->addComponent(EngineUtilities::MakeIntrusive<SeekTarget>(sf::Vector2f(400.0f, 300.0f), 200.0f));
 	}
 
-	// Triangle Actor
-	Triangle = EngineUtilities::MakeShared<Actor>("Triangle");
-	if (!Triangle.isNull()) {
-		Triangle->getComponent<ShapeFactory>()->createShape(ShapeType::TRIANGLE);
+	// Boids: una rejilla de crculos pequeos en el centro de la ventana.
+	m_actors.createEntities(48, "Boid", m_boids);
+	for (std::size_t i = 0; i < m_boids.size(); ++i) {
+		if (Actor* boid = m_actors.get(m_boids[i])) {
+			boid->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+			boid->getComponent<ShapeFactory>()->setPosition(320.0f + (i % 8) * 20.0f, 240.0f + (i / 8) * 20.0f);
+			boid->getComponent<ShapeFactory>()->setFillColor(sf::Color::Green);
+		}
 	}
 
+	// Muros: rectngulos grises que bloquean la rejilla de navegacin.
+	const sf::Vector2f wallPositions[] = { { 560.0f, 120.0f }, { 560.0f, 380.0f }, { 220.0f, 470.0f } };
+	m_actors.createEntities(3, "Wall", m_walls);
+	NavGrid navGrid(sf::Vector2f(0.0f, 0.0f), 20.0f, 40, 30);
+	for (std::size_t i = 0; i < m_walls.size(); ++i) {
+		if (Actor* wall = m_actors.get(m_walls[i])) {
+			wall->getComponent<ShapeFactory>()->createShape(ShapeType::RECTANGLE);
+			wall->getComponent<ShapeFactory>()->setPosition(wallPositions[i]);
+			wall->getComponent<ShapeFactory>()->setFillColor(sf::Color(128, 128, 128));
+			// Los caminos guan la esquina superior izquierda del buscador: se agranda
+			// el muro hacia arriba y a la izquierda lo que mide un crculo.
+			sf::FloatRect bounds = wall->getComponent<ShapeFactory>()->getGlobalBounds();
+			navGrid.blockRect(sf::FloatRect(bounds.left - 20.0f, bounds.top - 20.0f, bounds.width + 20.0f, bounds.height + 20.0f));
+		}
+	}
+	m_paths.setGrid(navGrid);
+
+	// Buscadores: todos piden camino en el primer fotograma.
+	m_actors.createEntities(24, "Seeker", m_seekers);
+	m_seekerGoals.resize(m_seekers.size());
+	for (std::size_t i = 0; i < m_seekers.size(); ++i) {
+		if (Actor* seeker = m_actors.get(m_seekers[i])) {
+			seeker->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+			seeker->getComponent<ShapeFactory>()->setPosition(20.0f + (i % 4) * 20.0f, 440.0f + (i / 4) * 20.0f);
+			seeker->getComponent<ShapeFactory>()->setFillColor(sf::Color::Magenta);
+			seeker->addComponent(EngineUtilities::MakeIntrusive<PathFollow>(PathAssetPtr(), 90.0f));
+		}
+		m_seekerGoals[i] = i % SeekerGoalCount;
+	}
+
+	// Systems
+	m_systems.addSystem<PathFollowSystem>(m_actors);
+	m_systems.addSystem<SeekSystem>(m_actors, 80.0f, 10.0f);
+
+	// La bandada deambula alrededor del centro y huye del crculo.
+	SteeringWeights flockWeights;
+	flockWeights.arrive = 0.3f;
+	flockWeights.wander = 0.5f;
+	flockWeights.evade = 2.0f;
+	flockWeights.separation = 1.5f;
+	flockWeights.alignment = 0.6f;
+	flockWeights.cohesion = 0.4f;
+	FlockingSystem* flock = m_systems.addSystem<FlockingSystem>(m_actors, m_boids, SteeringParams(), flockWeights);
+	flock->setTarget(sf::Vector2f(400.0f, 300.0f));
+	flock->setThreat(Circle);
+
 	return true;
 }
 
 /**
  * @brief Actualiza la lgica de la aplicacin.
  *
- * Este mtodo se encarga de obtener la posicin del mouse y actualiza el movimiento
- * del crculo hacia esa posicin. Tambin gestiona el recorrido entre los puntos de
- * referencia definidos.
+ * Este mtodo reconstruye la rejilla de actores, resalta el actor que est bajo el
+ * mouse y hace que el tringulo lo persiga, pide caminos para los buscadores y
+ * ejecuta los sistemas registrados, como el recorrido del crculo y las patrullas.
+ * Al final entrega los caminos terminados y lanza las bsquedas nuevas, que corren
+ * en los trabajadores mientras se renderiza.
  */
 void BaseApp::update() {
-	// Mouse Position
-	sf::Vector2i mousePosition = sf::Mouse::getPosition(*m_window->getWindow());
-	sf::Vector2f mousePosF(static_cast<float>(mousePosition.x),
-		static_cast<float>(mousePosition.y));
-
-	if (!Circle.isNull()) {
-		/*Circle->getComponent<ShapeFactory>()->Seek(mousePosF,
-																							 200.0f,
-																							 deltaTime.asSeconds(),
-																							 10.0f);*/
-		updateMovement(deltaTime.asSeconds(), Circle);
+	m_actorGrid.rebuild(m_actors);
+
+	// Mouse Position (sin ventana real no hay mouse)
+	if (!m_window->isHeadless()) {
+		sf::Vector2i mousePosition = sf::Mouse::getPosition(*m_window->getWindow());
+		const sf::Vector2f mouseWorld = m_window->getWindow()->mapPixelToCoords(mousePosition);
+		updateHover(mouseWorld);
+		if (Actor* triangle = m_actors.get(Triangle)) {
+			triangle->getComponentPtr<SeekTarget>()->setTarget(mouseWorld);
+		}
+	}
+
+	updateSeekers();
+	m_systems.update(m_world, deltaTime.asSeconds());
+	m_paths.update();
+}
+
+/**
+ * @brief Pide un camino nuevo para los buscadores que llegaron o no tienen uno.
+ *
+ * Si no hay camino a una esquina, el buscador pasa a la siguiente en el prximo fotograma.
+ */
+void BaseApp::updateSeekers() {
+	for (std::size_t i = 0; i < m_seekers.size(); ++i) {
+		Actor* seeker = m_actors.get(m_seekers[i]);
+		if (seeker == nullptr || m_paths.isPending(m_seekers[i])) continue;
+
+		const PathFollow* follow = seeker->getComponentPtr<PathFollow>();
+		if (follow->getPath() != nullptr && !follow->isFinished()) continue;
+
+		m_seekerGoals[i] = (m_seekerGoals[i] + 1) % SeekerGoalCount;
+		m_paths.requestPath(m_seekers[i], SeekerGoals[m_seekerGoals[i]]);
+	}
+}
+
+/**
+ * @brief Resalta el actor que est bajo el mouse.
+ * @param mousePosition Posicin del mouse en coordenadas de mundo.
+ */
+void BaseApp::updateHover(const sf::Vector2f& mousePosition) {
+	const ActorHandle picked = m_actorGrid.pick(mousePosition);
+	if (picked == m_hovered) return;
+
+	if (Actor* previous = m_actors.get(m_hovered)) {
+		previous->getComponent<ShapeFactory>()->setFillColor(m_hoveredColor);
+	}
+	m_hovered = picked;
+	if (Actor* hovered = m_actors.get(m_hovered)) {
+		m_hoveredColor = hovered->getComponent<ShapeFactory>()->getFillColor();
+		hovered->getComponent<ShapeFactory>()->setFillColor(sf::Color::Yellow);
 	}
 }
 
 /**
  * @brief Renderiza los actores en la ventana.
  *
- * Este mtodo limpia la ventana y dibuja los actores (Circle y Triangle)
- * antes de mostrar el contenido actualizado en pantalla.
+ * Este mtodo limpia la ventana y dibuja los actores de la escena que tocan
+ * la vista actual, en orden de identificador (el ndice de su espacio en el
+ * registro, que un actor nuevo puede heredar de uno destruido), antes de mostrar
+ * el contenido actualizado en pantalla. Los que quedan fuera de la vista no se envan.
  */
 void BaseApp::render() {
 	m_window->clear();
-	Circle->render(*m_window);
-	Triangle->render(*m_window);
+	m_actors.queryVisible(m_window->getViewBounds(), m_visibleActors);
+	for (Actor* actor : m_visibleActors) {
+		actor->render(*m_window);
+	}
 	m_window->display();
+
+	if (m_window->isHeadless()) {
+		m_rasterStats = m_window->getRasterizer().lastStats();
+		m_rasterMicroseconds += m_rasterStats.resolveMicroseconds;
+	}
 }
 
 /**
  * @brief Limpia y libera los recursos utilizados por la aplicacin.
  *
- * Este mtodo destruye la ventana y libera la memoria asociada a ella.
+ * Este mtodo destruye los actores y la ventana, y libera la memoria asociada. Tambin
+ * reporta la marca de agua mxima de la arena del fotograma para poder ajustar
+ * su tamao, la utilizacin de los hilos del JobSystem y el uso de la cach de caminos.
  */
 void BaseApp::cleanup() {
+	m_paths.dumpStats(std::cerr);
+	m_paths.clear();
+	m_systems.clear();
+	m_actors.clear();
+	m_world.clear();
+	const bool headless = m_window->isHeadless();
 	m_window->destroy();
 	delete m_window;
-}
 
-/**
- * @brief Actualiza el movimiento del crculo hacia el punto de recorrido actual.
- * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
- * @param circle Un puntero compartido al actor que representa el crculo.
- *
- * Este mtodo verifica si el crculo ha alcanzado su destino y, en caso
- * afirmativo, pasa al siguiente punto de referencia en el recorrido.
- */
-void BaseApp::updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Actor> circle) {
-	// Verificar si el Circle es nulo
-	if (!circle || circle.isNull()) return;
-
-	// Posicin actual del destino (punto de recorrido)
-	sf::Vector2f targetPos = waypoints[currentWaypoint];
-
-	// Llamar al Seek hacia el punto de recorrido actual
-	circle->getComponent<ShapeFactory>()->Seek(targetPos, 200.0f, deltaTime, 10.0f);
+	if (headless) {
+		std::ostringstream raster;
+		raster << "BaseApp::cleanup : [SOFTWARE RASTERIZER: " << m_frameCount << " frames, "
+			<< (m_frameCount > 0 ? m_rasterMicroseconds / m_frameCount : 0.0) << " us/frame, last frame "
+			<< m_rasterStats.triangles << " triangles in " << m_rasterStats.tilesTouched << " tiles] \n";
+		std::cerr << raster.str();
+	}
 
-	// Obtener la posicin actual del actor
-	sf::Vector2f currentPos = circle->getComponent<ShapeFactory>()->getShape()->getPosition();
+	std::ostringstream os;
+	os << "BaseApp::cleanup : [FRAME ARENA: high-water mark "
+		<< m_frameArena.highWaterMark() << " / " << m_frameArena.capacity()
+		<< " bytes, overflows " << m_frameArena.overflowCount() << "] \n";
+	std::cerr << os.str();
 
-	// Comprobar si el actor ha alcanzado el destino (o est cerca)
-	float distanceToTarget = std::sqrt(std::pow(targetPos.x - currentPos.x, 2) + std::pow(targetPos.y - currentPos.y, 2));
+	// Reparto de trabajo entre hilos durante la ejecucin.
+	JobSystem::instance().dumpStats(std::cerr);
 
-	if (distanceToTarget < 10.0f) { // Umbral para considerar que ha llegado
-		// Pasar al siguiente waypoint
-		currentWaypoint = (currentWaypoint + 1) % waypoints.size(); // Ciclar a travs de los puntos
-	}
+	// Con GALVAN_MEMORY_TRACKING, lo que siga vivo aqu es una fuga.
+	MEMORY_TRACK_DUMP(std::cerr);
 }
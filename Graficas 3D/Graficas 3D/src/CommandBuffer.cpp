@@ -0,0 +1,66 @@
+#include "CommandBuffer.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+/**
+ * @brief Crea un bfer para cada hilo del JobSystem global.
+ */
+CommandQueue::CommandQueue() {
+	const std::size_t threadCount = JobSystem::instance().workerCount() + 1;
+	for (std::size_t i = 0; i < threadCount; ++i) {
+		m_buffers.push_back(std::make_unique<CommandBuffer>());
+	}
+}
+
+/**
+ * @brief Obtiene un grabador sobre el bfer del hilo que llama.
+ * @param sortKey Clave de orden de la tarea que va a grabar.
+ * @return Grabador que pone esa clave en cada comando.
+ *
+ * Una tarea no cambia de hilo mientras corre, as que el bfer sigue siendo el suyo
+ * aunque ejecute otras tareas en lnea.
+ */
+CommandRecorder CommandQueue::local(std::uint64_t sortKey) {
+	return CommandRecorder(*m_buffers[JobSystem::instance().currentThreadIndex()], sortKey);
+}
+
+/**
+ * @brief Aplica todos los comandos grabados y vaca los bferes.
+ * @param registry Registro sobre el que se aplican.
+ * @return Nmero de comandos aplicados.
+ *
+ * Los comandos que se graben al aplicar (por ejemplo, desde la funcin de
+ * inicializacin de un actor) quedan para la siguiente llamada. Cada bfer alterna su
+ * memoria entre la lista que graba y la que se aplica, as que en un fotograma normal
+ * no se reserva memoria.
+ */
+std::size_t CommandQueue::apply(EntityRegistry& registry) {
+	bool empty = true;
+	for (const std::unique_ptr<CommandBuffer>& buffer : m_buffers) {
+		empty = empty && buffer->empty();
+	}
+	if (empty) {
+		return 0;
+	}
+
+	m_merged.clear();
+	for (const std::unique_ptr<CommandBuffer>& buffer : m_buffers) {
+		buffer->m_applying.swap(buffer->m_commands);
+		for (CommandBuffer::Command& command : buffer->m_applying) {
+			m_merged.push_back(&command);
+		}
+	}
+	std::stable_sort(m_merged.begin(), m_merged.end(),
+		[](const CommandBuffer::Command* a, const CommandBuffer::Command* b) { return a->sortKey < b->sortKey; });
+
+	for (CommandBuffer::Command* command : m_merged) {
+		command->apply(registry);
+	}
+
+	const std::size_t applied = m_merged.size();
+	m_merged.clear();
+	for (const std::unique_ptr<CommandBuffer>& buffer : m_buffers) {
+		buffer->m_applying.clear();
+	}
+	return applied;
+}
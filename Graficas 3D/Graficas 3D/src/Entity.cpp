@@ -0,0 +1,67 @@
+#include "Entity.h"
+#include "EntityQuery.h"
+#include "EntityRegistry.h"
+
+/**
+ * @brief Destructor virtual.
+ *
+ * Saca la entidad del cach de consultas para que ninguna vista conserve un puntero a ella.
+ */
+Entity::~Entity() {
+	if (queryCache != nullptr) {
+		queryCache->removeEntity(*this);
+	}
+}
+
+/**
+ * @brief Avisa al cach de consultas que cambi la mscara de la entidad.
+ * @param oldMask Mscara antes del cambio.
+ */
+void Entity::notifyComponentsChanged(ComponentMask oldMask) {
+	if (queryCache != nullptr) {
+		queryCache->onComponentsChanged(*this, oldMask);
+	}
+}
+
+/**
+ * @brief Avisa al registro que se agreg un componente.
+ * @param bit Bit del tipo del componente.
+ * @param component Componente agregado.
+ */
+void Entity::notifyComponentAttached(ComponentMask bit, Component& component) {
+	if (registry != nullptr) {
+		registry->onComponentAttached(*this, bit, component);
+	}
+}
+
+/**
+ * @brief Avisa al registro que se va a quitar un componente.
+ * @param bit Bit del tipo del componente.
+ * @param component Componente que se va a quitar.
+ */
+void Entity::notifyComponentDetached(ComponentMask bit, Component& component) {
+	if (registry != nullptr) {
+		registry->onComponentDetached(*this, bit, component);
+	}
+}
+
+/**
+ * @brief Quita todos los componentes de la entidad.
+ *
+ * Avisa al registro de cada componente y una sola vez al cach de consultas, con la
+ * mscara anterior completa.
+ */
+void Entity::removeAllComponents() {
+	if (componentMask == 0) {
+		return;
+	}
+	ComponentMask remaining = componentMask;
+	for (std::size_t slot = 0; remaining != 0; ++slot) {
+		notifyComponentDetached(remaining & (~remaining + 1), *components[slot]);
+		remaining &= remaining - 1;
+	}
+	components.clear();
+	const ComponentMask oldMask = componentMask;
+	componentMask = 0;
+	notifyComponentsChanged(oldMask);
+}
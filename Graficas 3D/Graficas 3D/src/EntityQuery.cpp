@@ -0,0 +1,126 @@
+#include "EntityQuery.h"
+
+/**
+ * @brief Constructor. Crea la consulta vaca que contiene todas las entidades.
+ */
+EntityQueryCache::EntityQueryCache() {
+	m_queries[0].mask = 0;
+}
+
+/**
+ * @brief Destructor. Desconecta las entidades que sigan registradas.
+ */
+EntityQueryCache::~EntityQueryCache() {
+	for (Entity* entity : m_queries[0].entities) {
+		entity->queryCache = nullptr;
+	}
+}
+
+/**
+ * @brief Registra una entidad y la agrega a las consultas que cumple.
+ * @param entity Entidad a registrar.
+ */
+void EntityQueryCache::addEntity(Entity& entity) {
+	if (entity.queryCache == this) {
+		return;
+	}
+	if (entity.queryCache != nullptr) {
+		ERROR("EntityQueryCache", "addEntity", "Entity is already registered in another cache");
+	}
+
+	entity.queryCache = this;
+	for (auto& pair : m_queries) {
+		if (pair.second.matches(entity.getComponentMask())) {
+			pair.second.add(&entity);
+		}
+	}
+}
+
+/**
+ * @brief Saca una entidad de todas las consultas.
+ * @param entity Entidad registrada.
+ */
+void EntityQueryCache::removeEntity(Entity& entity) {
+	if (entity.queryCache != this) {
+		return;
+	}
+
+	for (auto& pair : m_queries) {
+		if (pair.second.matches(entity.getComponentMask())) {
+			pair.second.remove(&entity);
+		}
+	}
+	entity.queryCache = nullptr;
+}
+
+/**
+ * @brief Actualiza las consultas afectadas por un cambio de componentes.
+ * @param entity Entidad que cambi.
+ * @param oldMask Mscara de la entidad antes del cambio.
+ *
+ * Solo se tocan las consultas cuyo resultado cambia: las que la entidad cumpla y ya no
+ * cumple, y al revs.
+ */
+void EntityQueryCache::onComponentsChanged(Entity& entity, ComponentMask oldMask) {
+	const ComponentMask newMask = entity.getComponentMask();
+	for (auto& pair : m_queries) {
+		Query& query = pair.second;
+		const bool before = query.matches(oldMask);
+		const bool after = query.matches(newMask);
+		if (before && !after) {
+			query.remove(&entity);
+		}
+		else if (!before && after) {
+			query.add(&entity);
+		}
+	}
+}
+
+/**
+ * @brief Busca una consulta o la crea.
+ * @param mask Componentes requeridos.
+ * @return La consulta.
+ *
+ * Una consulta nueva se llena recorriendo las entidades registradas una sola vez.
+ */
+EntityQueryCache::Query& EntityQueryCache::findOrCreateQuery(ComponentMask mask) {
+	auto it = m_queries.find(mask);
+	if (it != m_queries.end()) {
+		return it->second;
+	}
+
+	Query query;
+	query.mask = mask;
+	for (Entity* entity : m_queries[0].entities) {
+		if (query.matches(entity->getComponentMask())) {
+			query.add(entity);
+		}
+	}
+	return m_queries.emplace(mask, std::move(query)).first->second;
+}
+
+/**
+ * @brief Agrega una entidad al final de la consulta.
+ */
+void EntityQueryCache::Query::add(Entity* entity) {
+	positions[entity] = entities.size();
+	entities.push_back(entity);
+}
+
+/**
+ * @brief Quita una entidad; la ltima de la lista ocupa su lugar.
+ */
+void EntityQueryCache::Query::remove(const Entity* entity) {
+	auto it = positions.find(entity);
+	if (it == positions.end()) {
+		return;
+	}
+
+	const std::size_t position = it->second;
+	positions.erase(it);
+	if (position + 1 != entities.size()) {
+		entities[position] = entities.back();
+		positions[entities[position]] = position;
+	}
+	entities.pop_back();
+}
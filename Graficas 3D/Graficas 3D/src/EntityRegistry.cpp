@@ -0,0 +1,155 @@
+#include "EntityRegistry.h"
+#include <algorithm>
+
+/**
+ * @brief Destruye todos los actores.
+ */
+EntityRegistry::~EntityRegistry() {
+	clear();
+}
+
+/**
+ * @brief Crea un actor.
+ * @param name Nombre del actor.
+ * @return Handle del actor.
+ */
+ActorHandle EntityRegistry::createEntity(const std::string& name) {
+	ActorHandle handle = m_actors.create(name);
+	registerEntity(handle);
+	return handle;
+}
+
+/**
+ * @brief Crea varios actores de una vez.
+ * @param count Nmero de actores.
+ * @param name Nombre de los actores.
+ * @param out Vector al que se agregan los handles creados.
+ */
+void EntityRegistry::createEntities(std::size_t count, const std::string& name, std::vector<ActorHandle>& out) {
+	m_actors.reserve(m_actors.size() + count);
+	out.reserve(out.size() + count);
+	for (std::size_t i = 0; i < count; ++i) {
+		ActorHandle handle = m_actors.create(name);
+		registerEntity(handle);
+		out.push_back(handle);
+	}
+}
+
+/**
+ * @brief Marca un actor para destruirse.
+ * @param handle Handle del actor.
+ * @return true si el actor se marc.
+ */
+bool EntityRegistry::destroyEntity(ActorHandle handle) {
+	Actor* actor = m_actors.get(handle);
+	if (actor == nullptr || !actor->isActive) {
+		return false;
+	}
+	actor->isActive = false;
+	m_pendingDestroy.push_back(handle);
+	return true;
+}
+
+/**
+ * @brief Marca varios actores para destruirse.
+ * @param handles Primer handle del arreglo.
+ * @param count Nmero de handles.
+ */
+void EntityRegistry::destroyEntities(const ActorHandle* handles, std::size_t count) {
+	m_pendingDestroy.reserve(m_pendingDestroy.size() + count);
+	for (std::size_t i = 0; i < count; ++i) {
+		destroyEntity(handles[i]);
+	}
+}
+
+/**
+ * @brief Destruye todos los actores marcados.
+ */
+void EntityRegistry::flushDestroyed() {
+	if (m_pendingDestroy.empty()) {
+		return;
+	}
+
+	for (ActorHandle handle : m_pendingDestroy) {
+		m_actors.get(handle)->destroy();
+	}
+	for (ActorHandle handle : m_pendingDestroy) {
+		m_actors.destroy(handle);
+	}
+	m_pendingDestroy.clear();
+}
+
+/**
+ * @brief Destruye todos los actores, marcados o no.
+ */
+void EntityRegistry::clear() {
+	m_pendingDestroy.clear();
+	m_actors.forEach([](ActorHandle, Actor& actor) {
+		actor.destroy();
+	});
+	m_actors.clear();
+	m_bounds.clear();
+}
+
+/**
+ * @brief Busca los actores activos cuya forma toca un rectngulo.
+ * @param rect Rectngulo en espacio de mundo.
+ * @param out Vector que se vaca y se llena con los actores, en orden de ndice.
+ */
+void EntityRegistry::queryVisible(const sf::FloatRect& rect, std::vector<Actor*>& out) {
+	out.clear();
+	m_bounds.query(rect, [this, &out](int proxyId) {
+		Actor* actor = static_cast<Actor*>(m_bounds.getUserData(proxyId));
+		if (actor->getIsActive()) {
+			out.push_back(actor);
+		}
+		return true;
+	});
+	std::sort(out.begin(), out.end(), [](const Actor* a, const Actor* b) {
+		return a->getId() < b->getId();
+	});
+}
+
+/**
+ * @brief Asigna identificador y registra en el cach y en el rbol de cajas un actor
+ * recin creado.
+ * @param handle Handle del actor.
+ */
+void EntityRegistry::registerEntity(ActorHandle handle) {
+	Actor* actor = m_actors.get(handle);
+	actor->id = static_cast<int>(handle.index);
+	actor->isActive = true;
+	actor->registry = this;
+	m_queries.addEntity(*actor);
+	if (ShapeFactory* shape = actor->getComponentPtr<ShapeFactory>()) {
+		shape->attachSpatialIndex(&m_bounds, actor);
+	}
+}
+
+/**
+ * @brief Conecta al rbol de cajas la forma que se agrega a un actor.
+ * @param entity Actor del registro.
+ * @param bit Bit del tipo del componente.
+ * @param component Componente agregado.
+ */
+void EntityRegistry::onComponentAttached(Entity& entity, ComponentMask bit, Component& component) {
+	if (bit == ComponentBit<ShapeFactory>()) {
+		static_cast<ShapeFactory&>(component).attachSpatialIndex(&m_bounds, static_cast<Actor*>(&entity));
+	}
+}
+
+/**
+ * @brief Saca del rbol de cajas la forma que se quita de un actor.
+ * @param entity Actor del registro.
+ * @param bit Bit del tipo del componente.
+ * @param component Componente que se va a quitar.
+ *
+ * `Actor::destroy` quita todos los componentes, as que tambin pasa por aqu: la forma
+ * puede sobrevivir al actor si alguien ms la referencia, y el rbol no debe quedarse
+ * apuntando a un actor destruido.
+ */
+void EntityRegistry::onComponentDetached(Entity& entity, ComponentMask bit, Component& component) {
+	if (bit == ComponentBit<ShapeFactory>()) {
+		static_cast<ShapeFactory&>(component).detachSpatialIndex();
+	}
+}
@@ -0,0 +1,69 @@
+#include "FlockingSystem.h"
+
+/**
+ * @brief Constructor.
+ * @param actors Registro de actores de la aplicacin.
+ * @param agents Actores del grupo.
+ * @param params Lmites y distancias de los comportamientos.
+ * @param weights Pesos de la mezcla.
+ */
+FlockingSystem::FlockingSystem(EntityRegistry& actors,
+                               std::vector<ActorHandle> agents,
+                               const SteeringParams& params,
+                               const SteeringWeights& weights)
+	: System("FlockingSystem"), m_actors(actors), m_agents(std::move(agents)) {
+	writes<ShapeFactory>();
+	m_group.setParams(params);
+	m_group.setWeights(weights);
+
+	for (ActorHandle agent : m_agents) {
+		sf::Vector2f position;
+		if (Actor* actor = m_actors.get(agent)) {
+			if (ShapeFactory* shape = actor->getComponentPtr<ShapeFactory>()) {
+				position = shape->getPosition();
+			}
+		}
+		m_group.addAgent(position);
+	}
+}
+
+/**
+ * @brief Actor del que se alejan Flee y Evade.
+ */
+void FlockingSystem::setThreat(ActorHandle threat) {
+	m_threat = threat;
+	m_hasThreatPosition = false;
+}
+
+/**
+ * @brief Avanza el grupo y mueve los actores.
+ * @param world World de la aplicacin (no se usa).
+ * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+ *
+ * Los agentes cuyo actor ya no existe se siguen simulando, pero no se escriben.
+ */
+void FlockingSystem::update(World& world, float deltaTime) {
+	if (Actor* threat = m_actors.get(m_threat)) {
+		if (ShapeFactory* shape = threat->getComponentPtr<ShapeFactory>()) {
+			const sf::Vector2f position = shape->getPosition();
+			sf::Vector2f velocity;
+			if (m_hasThreatPosition && deltaTime > 0.0f) {
+				velocity = (position - m_lastThreatPosition) / deltaTime;
+			}
+			m_group.setThreat(position, velocity);
+			m_lastThreatPosition = position;
+			m_hasThreatPosition = true;
+		}
+	}
+
+	m_group.update(deltaTime);
+
+	for (std::size_t i = 0; i < m_agents.size(); ++i) {
+		Actor* actor = m_actors.get(m_agents[i]);
+		if (actor == nullptr) continue;
+
+		if (ShapeFactory* shape = actor->getComponentPtr<ShapeFactory>()) {
+			shape->setPosition(m_group.getPosition(i));
+		}
+	}
+}
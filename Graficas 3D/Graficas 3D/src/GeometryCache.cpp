@@ -0,0 +1,167 @@
+#include "GeometryCache.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/**
+ * @brief Obtiene la instancia global del cach.
+ */
+GeometryCache& GeometryCache::instance() {
+	static GeometryCache cache;
+	return cache;
+}
+
+/**
+ * @brief Obtiene la geometra de un polgono regular inscrito en un crculo.
+ * @param radius Radio del crculo.
+ * @param pointCount Nmero de lados.
+ */
+ShapeMeshPtr GeometryCache::getCircle(float radius, std::size_t pointCount) {
+	ShapeMeshKey key;
+	key.type = ShapeType::CIRCLE;
+	key.width = radius;
+	key.pointCount = pointCount;
+	return get(key);
+}
+
+/**
+ * @brief Obtiene la geometra de un rectngulo con esquina en el origen.
+ * @param size Ancho y alto.
+ */
+ShapeMeshPtr GeometryCache::getRectangle(const sf::Vector2f& size) {
+	ShapeMeshKey key;
+	key.type = ShapeType::RECTANGLE;
+	key.width = size.x;
+	key.height = size.y;
+	key.pointCount = 4;
+	return get(key);
+}
+
+/**
+ * @brief Obtiene la geometra de una clave, crendola si no existe.
+ * @param key Tipo y parmetros de la forma.
+ * @return La geometra, o un puntero vaco si el tipo es EMPTY.
+ *
+ * Un tringulo es un crculo de tres lados, as que comparte clave con l.
+ */
+ShapeMeshPtr GeometryCache::get(const ShapeMeshKey& key) {
+	if (key.type == ShapeType::EMPTY) {
+		return ShapeMeshPtr();
+	}
+
+	ShapeMeshKey normalized = key;
+	if (normalized.type == ShapeType::TRIANGLE) {
+		normalized.type = ShapeType::CIRCLE;
+		normalized.pointCount = 3;
+	}
+	if (normalized.type == ShapeType::CIRCLE) {
+		normalized.height = 0.0f;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_meshes.find(normalized);
+	if (it != m_meshes.end()) {
+		return it->second;
+	}
+
+	ShapeMeshPtr mesh = EngineUtilities::MakeShared<ShapeMesh>();
+	build(normalized, *mesh);
+	m_meshes.emplace(normalized, mesh);
+	return mesh;
+}
+
+/**
+ * @brief Suelta las geometras que ya solo referencia el cach.
+ * @return Nmero de geometras liberadas.
+ */
+std::size_t GeometryCache::purgeUnused() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::size_t released = 0;
+	for (auto it = m_meshes.begin(); it != m_meshes.end();) {
+		if (it->second.useCount() == 1) {
+			it = m_meshes.erase(it);
+			++released;
+		}
+		else {
+			++it;
+		}
+	}
+	return released;
+}
+
+/**
+ * @brief Suelta todas las geometras.
+ */
+void GeometryCache::clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_meshes.clear();
+}
+
+/**
+ * @brief Nmero de geometras en el cach.
+ */
+std::size_t GeometryCache::size() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_meshes.size();
+}
+
+/**
+ * @brief Tesela la geometra de una clave.
+ * @param key Clave normalizada (solo CIRCLE o RECTANGLE).
+ * @param mesh Geometra a llenar.
+ *
+ * Los puntos se calculan igual que en SFML: el crculo empieza arriba y su caja
+ * local va de (0, 0) a (2r, 2r); el rectngulo tiene la esquina en el origen.
+ */
+void GeometryCache::build(const ShapeMeshKey& key, ShapeMesh& mesh) {
+	if (key.type == ShapeType::RECTANGLE) {
+		mesh.points = {
+			{ 0.0f, 0.0f },
+			{ key.width, 0.0f },
+			{ key.width, key.height },
+			{ 0.0f, key.height }
+		};
+	}
+	else {
+		const float pi = 3.141592654f;
+		const std::size_t count = std::max<std::size_t>(key.pointCount, 3);
+		mesh.points.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			const float angle = i * 2.0f * pi / count - pi / 2.0f;
+			mesh.points.emplace_back(std::cos(angle) * key.width + key.width,
+			                         std::sin(angle) * key.width + key.width);
+		}
+	}
+
+	// Relleno en abanico desde el primer punto.
+	mesh.triangles.reserve((mesh.points.size() - 2) * 3);
+	for (std::size_t i = 2; i < mesh.points.size(); ++i) {
+		mesh.triangles.push_back(mesh.points[0]);
+		mesh.triangles.push_back(mesh.points[i - 1]);
+		mesh.triangles.push_back(mesh.points[i]);
+	}
+
+	sf::Vector2f low = mesh.points[0];
+	sf::Vector2f high = low;
+	for (const sf::Vector2f& point : mesh.points) {
+		low.x = std::min(low.x, point.x);
+		low.y = std::min(low.y, point.y);
+		high.x = std::max(high.x, point.x);
+		high.y = std::max(high.y, point.y);
+	}
+	mesh.bounds = sf::FloatRect(low.x, low.y, high.x - low.x, high.y - low.y);
+}
+
+/**
+ * @brief Hash de `ShapeMeshKey`.
+ */
+std::size_t GeometryCache::KeyHash::operator()(const ShapeMeshKey& key) const {
+	std::size_t hash = std::hash<int>()(static_cast<int>(key.type));
+	auto combine = [&hash](std::size_t value) {
+		hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	};
+	combine(std::hash<float>()(key.width));
+	combine(std::hash<float>()(key.height));
+	combine(std::hash<std::size_t>()(key.pointCount));
+	return hash;
+}
@@ -1,4 +1,7 @@
 #include "BaseApp.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 
 /**
  * @brief Punto de entrada de la aplicacin.
@@ -7,9 +10,27 @@
  * de BaseApp y llamando a su mtodo run() para ejecutar el ciclo de vida
  * de la aplicacin.
  *
+ * Con `--headless <fotogramas> [imagen]` se dibuja en la CPU sin abrir ventana,
+ * se ejecuta ese nmero de fotogramas y, si se indica, se guarda el ltimo. El nmero
+ * de fotogramas debe ser un entero mayor que 0; si no, se muestra el uso y se sale con
+ * error, porque un lmite de 0 hara que la aplicacin no terminara nunca.
+ *
  * @return Un valor entero que indica el estado de la aplicacin al cerrarse.
  */
-int main() {
+int main(int argc, char* argv[]) {
+	if (argc >= 2 && std::string(argv[1]) == "--headless") {
+		char* end = nullptr;
+		errno = 0;
+		const long frames = argc >= 3 ? std::strtol(argv[2], &end, 10) : 0;
+		if (argc < 3 || end == argv[2] || *end != '\0' || errno == ERANGE || frames <= 0 || frames > INT_MAX) {
+			std::cerr << "Usage: " << argv[0] << " [--headless <frames> [image]]\n"
+				<< "  <frames> must be an integer greater than 0\n";
+			return 1;
+		}
+		BaseApp app(SOFTWARE, static_cast<int>(frames), argc >= 4 ? argv[3] : "");
+		return app.run();
+	}
+
 	BaseApp app; // Crea una instancia de BaseApp.
 	return app.run(); // Llama al mtodo run() para iniciar la aplicacin.
 }
@@ -0,0 +1,236 @@
+#include "JobSystem.h"
+
+namespace {
+	/// Cola del hilo actual: 0 para hilos externos, 1..n para trabajadores.
+	thread_local std::size_t t_queueIndex = 0;
+
+	/// JobSystem al que pertenece el hilo actual, si es un trabajador.
+	thread_local const JobSystem* t_owner = nullptr;
+}
+
+/**
+ * @brief Obtiene la instancia global.
+ */
+JobSystem& JobSystem::instance() {
+	static JobSystem jobSystem(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return jobSystem;
+}
+
+/**
+ * @brief Crea el sistema con un nmero fijo de trabajadores.
+ * @param workerCount Nmero de hilos trabajadores (al menos uno).
+ */
+JobSystem::JobSystem(std::size_t workerCount) {
+	workerCount = std::max<std::size_t>(workerCount, 1);
+	for (std::size_t i = 0; i <= workerCount; ++i) {
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+
+	m_statsStart = std::chrono::steady_clock::now();
+	for (std::size_t i = 1; i <= workerCount; ++i) {
+		m_threads.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+/**
+ * @brief Termina los trabajadores.
+ */
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stopping.store(true);
+	}
+	m_wake.notify_all();
+	for (std::thread& thread : m_threads) {
+		thread.join();
+	}
+}
+
+/**
+ * @brief Programa un trabajo.
+ * @param task Funcin a ejecutar.
+ * @param counter Contador opcional que se decrementa cuando el trabajo termina.
+ *
+ * Desde un trabajador, el trabajo va a su propia cola; desde otro hilo, a la cola externa.
+ */
+void JobSystem::schedule(std::function<void()> task, JobCounter* counter) {
+	if (counter != nullptr) {
+		counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Queue& queue = *m_queues[currentQueue()];
+	{
+		std::lock_guard<EngineUtilities::SpinLock> lock(queue.lock);
+		queue.jobs.push_back(Job{ std::move(task), counter });
+	}
+	m_queuedJobs.fetch_add(1, std::memory_order_release);
+	m_wake.notify_one();
+}
+
+/**
+ * @brief Espera a que terminen los trabajos de un contador.
+ * @param counter Contador a esperar.
+ */
+void JobSystem::wait(const JobCounter& counter) {
+	const std::size_t index = currentQueue();
+	while (!counter.isDone()) {
+		if (!tryRunJob(index)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+/**
+ * @brief Obtiene las estadsticas de un hilo.
+ * @param index ndice de la cola del hilo.
+ */
+JobWorkerStats JobSystem::getStats(std::size_t index) const {
+	JobWorkerStats stats;
+	if (index >= m_queues.size()) {
+		return stats;
+	}
+
+	const Queue& queue = *m_queues[index];
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_statsStart).count();
+	stats.jobsExecuted = queue.jobsExecuted.load(std::memory_order_relaxed);
+	stats.jobsStolen = queue.jobsStolen.load(std::memory_order_relaxed);
+	stats.busySeconds = queue.busyNanoseconds.load(std::memory_order_relaxed) * 1e-9;
+	stats.utilization = elapsed > 0.0 ? stats.busySeconds / elapsed : 0.0;
+	return stats;
+}
+
+/**
+ * @brief Reinicia las estadsticas de todos los hilos.
+ */
+void JobSystem::resetStats() {
+	for (std::unique_ptr<Queue>& queue : m_queues) {
+		queue->jobsExecuted.store(0, std::memory_order_relaxed);
+		queue->jobsStolen.store(0, std::memory_order_relaxed);
+		queue->busyNanoseconds.store(0, std::memory_order_relaxed);
+	}
+	m_statsStart = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Escribe las estadsticas de todos los hilos.
+ * @param os Flujo de salida.
+ */
+void JobSystem::dumpStats(std::ostream& os) const {
+	std::ostringstream out;
+	out << "JobSystem::dumpStats : [" << m_threads.size() << " workers] \n";
+	for (std::size_t i = 0; i < m_queues.size(); ++i) {
+		JobWorkerStats stats = getStats(i);
+		out << "  " << (i == 0 ? std::string("external") : "worker " + std::to_string(i))
+			<< " : jobs " << stats.jobsExecuted
+			<< ", stolen " << stats.jobsStolen
+			<< ", busy " << stats.busySeconds << " s"
+			<< ", utilization " << stats.utilization * 100.0 << "% \n";
+	}
+	os << out.str();
+}
+
+/**
+ * @brief Bucle de un hilo trabajador.
+ * @param index ndice de la cola del trabajador.
+ *
+ * Si no encuentra trabajo, duerme hasta que se programe uno. La espera tiene un
+ * lmite corto por si un aviso llega justo antes de dormir.
+ */
+void JobSystem::workerLoop(std::size_t index) {
+	t_queueIndex = index;
+	t_owner = this;
+
+	while (!m_stopping.load(std::memory_order_acquire)) {
+		if (tryRunJob(index)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wake.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+			return m_stopping.load(std::memory_order_acquire)
+				|| m_queuedJobs.load(std::memory_order_acquire) > 0;
+		});
+	}
+}
+
+/**
+ * @brief Ejecuta un trabajo de la cola propia o, si est vaca, uno robado.
+ * @param index Cola del hilo que llama.
+ * @return true si ejecut un trabajo.
+ */
+bool JobSystem::tryRunJob(std::size_t index) {
+	Job job;
+	if (popLocal(index, job)) {
+		execute(index, job);
+		return true;
+	}
+	if (steal(index, job)) {
+		m_queues[index]->jobsStolen.fetch_add(1, std::memory_order_relaxed);
+		execute(index, job);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Saca el trabajo ms reciente de la cola propia.
+ */
+bool JobSystem::popLocal(std::size_t index, Job& job) {
+	Queue& queue = *m_queues[index];
+	std::lock_guard<EngineUtilities::SpinLock> lock(queue.lock);
+	if (queue.jobs.empty()) {
+		return false;
+	}
+	job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+/**
+ * @brief Roba el trabajo ms antiguo de la cola de otro hilo.
+ *
+ * Recorre las dems colas empezando por la siguiente a la propia; las colas
+ * ocupadas por otro ladrn se saltan en lugar de esperar.
+ */
+bool JobSystem::steal(std::size_t thief, Job& job) {
+	const std::size_t count = m_queues.size();
+	for (std::size_t offset = 1; offset < count; ++offset) {
+		Queue& queue = *m_queues[(thief + offset) % count];
+		std::unique_lock<EngineUtilities::SpinLock> lock(queue.lock, std::try_to_lock);
+		if (!lock.owns_lock() || queue.jobs.empty()) {
+			continue;
+		}
+		job = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+		m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Ejecuta un trabajo, mide su duracin y decrementa su contador.
+ */
+void JobSystem::execute(std::size_t index, Job& job) {
+	const auto start = std::chrono::steady_clock::now();
+	job.task();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	Queue& queue = *m_queues[index];
+	queue.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+	queue.busyNanoseconds.fetch_add(
+		static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+		std::memory_order_relaxed);
+
+	if (job.counter != nullptr) {
+		job.counter->m_pending.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+/**
+ * @brief ndice de la cola del hilo actual para este JobSystem.
+ */
+std::size_t JobSystem::currentQueue() const {
+	return t_owner == this ? t_queueIndex : 0;
+}
@@ -0,0 +1,49 @@
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constructor.
+ * @param origin Esquina superior izquierda de la rejilla.
+ * @param cellSize Lado de cada celda.
+ * @param width Nmero de columnas.
+ * @param height Nmero de filas.
+ */
+NavGrid::NavGrid(const sf::Vector2f& origin, float cellSize, std::uint32_t width, std::uint32_t height)
+	: m_origin(origin), m_cellSize(cellSize), m_width(width), m_height(height),
+	m_walkable(static_cast<std::size_t>(width) * height, 1) {
+}
+
+/**
+ * @brief Marca como ocupadas las celdas que toca un rectngulo.
+ * @param rect Rectngulo en coordenadas de mundo.
+ */
+void NavGrid::blockRect(const sf::FloatRect& rect) {
+	if (m_walkable.empty()) return;
+
+	const float invCell = 1.0f / m_cellSize;
+	const int maxX = static_cast<int>(m_width) - 1;
+	const int maxY = static_cast<int>(m_height) - 1;
+	const int x0 = std::max(0, static_cast<int>(std::floor((rect.left - m_origin.x) * invCell)));
+	const int y0 = std::max(0, static_cast<int>(std::floor((rect.top - m_origin.y) * invCell)));
+	const int x1 = std::min(maxX, static_cast<int>(std::floor((rect.left + rect.width - m_origin.x) * invCell)));
+	const int y1 = std::min(maxY, static_cast<int>(std::floor((rect.top + rect.height - m_origin.y) * invCell)));
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			m_walkable[toIndex(x, y)] = 0;
+		}
+	}
+}
+
+/**
+ * @brief Celda que contiene un punto, o la ms cercana si cae fuera.
+ * @param point Punto en coordenadas de mundo.
+ */
+std::uint32_t NavGrid::cellAt(const sf::Vector2f& point) const {
+	const float invCell = 1.0f / m_cellSize;
+	const int x = static_cast<int>(std::floor((point.x - m_origin.x) * invCell));
+	const int y = static_cast<int>(std::floor((point.y - m_origin.y) * invCell));
+	return toIndex(std::clamp(x, 0, static_cast<int>(m_width) - 1),
+		std::clamp(y, 0, static_cast<int>(m_height) - 1));
+}
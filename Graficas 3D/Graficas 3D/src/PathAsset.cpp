@@ -0,0 +1,80 @@
+#include "PathAsset.h"
+#include <algorithm>
+
+/**
+ * @brief Constructor.
+ * @param points Puntos del recorrido, en orden.
+ * @param closed Si el ltimo punto se une con el primero.
+ *
+ * Calcula una sola vez el largo de cada tramo (la nica raz cuadrada) y la longitud
+ * de arco acumulada.
+ */
+PathAsset::PathAsset(std::vector<sf::Vector2f> points, bool closed)
+	: m_points(std::move(points)), m_closed(closed) {
+	if (m_closed && m_points.size() > 1) {
+		m_points.push_back(m_points.front());
+	}
+
+	m_arcLengths.push_back(0.0f);
+	for (std::size_t i = 0; i + 1 < m_points.size(); ++i) {
+		const sf::Vector2f delta = m_points[i + 1] - m_points[i];
+		const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+		m_deltas.push_back(delta);
+		m_segmentLengths.push_back(length);
+		m_invSegmentLengths.push_back(length > 0.0f ? 1.0f / length : 0.0f);
+		m_length += length;
+		m_arcLengths.push_back(m_length);
+	}
+	m_invLength = m_length > 0.0f ? 1.0f / m_length : 0.0f;
+}
+
+/**
+ * @brief Posicin a una distancia recorrida.
+ * @param distance Distancia desde el primer punto.
+ * @return La posicin, o el nico punto (o el origen) si el recorrido no tiene tramos.
+ */
+sf::Vector2f PathAsset::sample(float distance) const {
+	if (m_segmentLengths.empty()) {
+		return m_points.empty() ? sf::Vector2f() : m_points.front();
+	}
+	const float wrapped = wrap(distance);
+	return pointOnSegment(findSegment(wrapped), wrapped);
+}
+
+/**
+ * @brief Posiciones de varios agentes a la vez.
+ * @param distances Distancias, ya dentro del rango del recorrido.
+ * @param count Nmero de agentes.
+ * @param positionX Destino de las posiciones X.
+ * @param positionY Destino de las posiciones Y.
+ */
+void PathAsset::sampleBatch(const float* distances, std::size_t count, float* positionX, float* positionY) const {
+	if (m_segmentLengths.empty()) {
+		const sf::Vector2f point = sample(0.0f);
+		std::fill(positionX, positionX + count, point.x);
+		std::fill(positionY, positionY + count, point.y);
+		return;
+	}
+
+	std::size_t segment = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		const float distance = distances[i];
+		if (distance < m_arcLengths[segment] || distance > m_arcLengths[segment + 1]) {
+			segment = findSegment(distance);
+		}
+		const sf::Vector2f point = pointOnSegment(segment, distance);
+		positionX[i] = point.x;
+		positionY[i] = point.y;
+	}
+}
+
+/**
+ * @brief Tramo que contiene una distancia ya dentro del rango.
+ *
+ * Busca el ltimo tramo que empieza antes de la distancia; la longitud total cae en
+ * el ltimo tramo.
+ */
+std::size_t PathAsset::findSegment(float distance) const {
+	const auto it = std::upper_bound(m_arcLengths.begin() + 1, m_arcLengths.end() - 1, distance);
+	return static_cast<std::size_t>(it - m_arcLengths.begin()) - 1;
+}
@@ -0,0 +1,86 @@
+#include "PathFollowSystem.h"
+#include "JobSystem.h"
+
+namespace {
+	/// Actores por trabajo al calcular posiciones.
+	constexpr std::size_t SampleGrain = 1024;
+}
+
+/**
+ * @brief Constructor.
+ * @param actors Registro de actores de la aplicacin.
+ */
+PathFollowSystem::PathFollowSystem(EntityRegistry& actors)
+	: System("PathFollowSystem"), m_actors(actors) {
+	writes<PathFollow, ShapeFactory>();
+}
+
+/**
+ * @brief Avanza a todos los actores por su recorrido.
+ * @param world World de la aplicacin (no se usa).
+ * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+ *
+ * La escritura final es en serie porque `ShapeFactory::setPosition` actualiza el
+ * ndice espacial del registro.
+ */
+void PathFollowSystem::update(World& world, float deltaTime) {
+	// Agrupar por recorrido.
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		Batch& batch = m_batches[i];
+		batch.agents.clear();
+		batch.distance.clear();
+		batch.speed.clear();
+	}
+	m_batchCount = 0;
+	m_batchOf.clear();
+
+	for (Entity* entity : m_actors.getQueries().view<PathFollow, ShapeFactory>()) {
+		if (!entity->getIsActive()) continue;
+
+		const PathFollow* follow = entity->getComponentPtr<PathFollow>();
+		const PathAsset* path = follow->getPath();
+		if (path == nullptr) continue;
+
+		auto found = m_batchOf.find(path);
+		if (found == m_batchOf.end()) {
+			if (m_batchCount == m_batches.size()) {
+				m_batches.emplace_back();
+			}
+			m_batches[m_batchCount].path = path;
+			found = m_batchOf.emplace(path, m_batchCount++).first;
+		}
+		Batch& batch = m_batches[found->second];
+		batch.agents.push_back(entity);
+		batch.distance.push_back(follow->m_distance);
+		batch.speed.push_back(follow->m_speed);
+	}
+
+	// Avanzar y calcular posiciones.
+	JobSystem& jobs = JobSystem::instance();
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		Batch& batch = m_batches[i];
+		const std::size_t count = batch.agents.size();
+		batch.positionX.resize(count);
+		batch.positionY.resize(count);
+
+		jobs.parallelFor(count, SampleGrain, [&batch, deltaTime](std::size_t begin, std::size_t end) {
+			const PathAsset& path = *batch.path;
+			float* distance = batch.distance.data();
+			const float* speed = batch.speed.data();
+			for (std::size_t k = begin; k < end; ++k) {
+				distance[k] = path.wrap(distance[k] + speed[k] * deltaTime);
+			}
+			path.sampleBatch(distance + begin, end - begin, batch.positionX.data() + begin, batch.positionY.data() + begin);
+		});
+	}
+
+	// Escribir de vuelta.
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		Batch& batch = m_batches[i];
+		for (std::size_t k = 0; k < batch.agents.size(); ++k) {
+			Entity* entity = batch.agents[k];
+			entity->getComponentPtr<PathFollow>()->m_distance = batch.distance[k];
+			entity->getComponentPtr<ShapeFactory>()->setPosition(batch.positionX[k], batch.positionY[k]);
+		}
+	}
+}
@@ -0,0 +1,321 @@
+#include "PathService.h"
+#include "ShapeFactory.h"
+
+namespace {
+	/// Bsquedas por trabajo. Son pocas para que un hilo que espera otro contador y toma
+	/// uno de estos trabajos se libere pronto.
+	constexpr std::size_t SearchGrain = 8;
+
+	/**
+	 * @brief Junta la celda de inicio y la de destino en una sola clave.
+	 */
+	std::uint64_t pathKey(std::uint32_t start, std::uint32_t goal) {
+		return (static_cast<std::uint64_t>(start) << 32) | goal;
+	}
+}
+
+/**
+ * @brief Constructor.
+ * @param actors Registro de actores de la aplicacin.
+ * @param cacheCapacity Caminos que guarda la cach.
+ */
+PathService::PathService(EntityRegistry& actors, std::size_t cacheCapacity)
+	: m_actors(actors), m_cacheCapacity(cacheCapacity) {
+}
+
+/**
+ * @brief Destructor; los trabajos en curso usan este objeto, as que hay que esperarlos.
+ */
+PathService::~PathService() {
+	waitInFlight();
+}
+
+/**
+ * @brief Cambia la rejilla de navegacin.
+ * @param grid Rejilla nueva.
+ *
+ * Crea de una vez un buscador por hilo con memoria para todas las celdas. Los resultados
+ * en curso se buscaron con celdas de la rejilla anterior, as que se descartan y cada
+ * peticin pendiente se vuelve a encolar con sus celdas en la rejilla nueva. Si la rejilla
+ * nueva no tiene celdas, esos actores reciben un recorrido vaco.
+ */
+void PathService::setGrid(NavGrid grid) {
+	waitInFlight();
+	for (std::unique_ptr<Batch>& batch : m_inFlight) {
+		m_freeBatches.push_back(std::move(batch));
+	}
+	m_inFlight.clear();
+	m_grid = std::move(grid);
+	m_cache.clear();
+	m_cacheIndex.clear();
+
+	m_queued.clear();
+	m_waiting.clear();
+	if (m_grid.getCellCount() == 0) {
+		for (const auto& entry : m_requests) {
+			Actor* actor = m_actors.get(entry.second.agent);
+			if (PathFollow* follow = actor != nullptr ? actor->getComponentPtr<PathFollow>() : nullptr) {
+				follow->setPath(PathAssetPtr());
+			}
+		}
+		m_requests.clear();
+	}
+	for (auto& entry : m_requests) {
+		Request& request = entry.second;
+		request.key = pathKey(m_grid.cellAt(request.start), m_grid.cellAt(request.goal));
+		enqueue(request);
+	}
+
+	m_pathfinders.clear();
+	for (std::size_t i = 0; i <= JobSystem::instance().workerCount(); ++i) {
+		m_pathfinders.push_back(std::make_unique<Pathfinder>(m_grid.getCellCount()));
+	}
+}
+
+/**
+ * @brief Pide un camino desde la posicin actual de un actor.
+ * @param agent Actor con `PathFollow` y `ShapeFactory`.
+ * @param goal Destino en coordenadas de mundo.
+ */
+void PathService::requestPath(ActorHandle agent, const sf::Vector2f& goal) {
+	Actor* actor = m_actors.get(agent);
+	if (actor == nullptr || m_grid.getCellCount() == 0) return;
+	const ShapeFactory* shape = actor->getComponentPtr<ShapeFactory>();
+	if (shape == nullptr) return;
+
+	++m_requestCount;
+	Request request;
+	request.agent = agent;
+	request.start = shape->getPosition();
+	request.goal = goal;
+	request.key = pathKey(m_grid.cellAt(request.start), m_grid.cellAt(request.goal));
+	if (const PathAssetPtr* cached = findCached(request.key)) {
+		++m_cacheHits;
+		m_requests.erase(handleKey(agent));
+		if (PathFollow* follow = actor->getComponentPtr<PathFollow>()) {
+			follow->setPath(*cached);
+		}
+		return;
+	}
+
+	m_requests[handleKey(agent)] = request;
+	enqueue(request);
+}
+
+/**
+ * @brief Entrega los caminos terminados y lanza las bsquedas pendientes.
+ */
+void PathService::update() {
+	collect();
+	dispatch();
+}
+
+/**
+ * @brief Espera a las bsquedas en curso y descarta peticiones y cach.
+ */
+void PathService::clear() {
+	waitInFlight();
+	for (std::unique_ptr<Batch>& batch : m_inFlight) {
+		m_freeBatches.push_back(std::move(batch));
+	}
+	m_inFlight.clear();
+	m_queued.clear();
+	m_waiting.clear();
+	m_requests.clear();
+	m_cache.clear();
+	m_cacheIndex.clear();
+}
+
+/**
+ * @brief Escribe las estadsticas del servicio.
+ * @param os Flujo de salida.
+ */
+void PathService::dumpStats(std::ostream& os) const {
+	std::ostringstream out;
+	out << "PathService::dumpStats : [" << m_requestCount << " requests, "
+		<< m_cacheHits << " cache hits, " << m_searches << " searches, "
+		<< m_failures << " without path, " << m_cache.size() << " / " << m_cacheCapacity << " cached] \n";
+	os << out.str();
+}
+
+/**
+ * @brief Ejecuta las bsquedas de un trabajo; corre en cualquier hilo.
+ * @param batch Trabajo a ejecutar.
+ *
+ * Toma un buscador libre (o crea uno si todos estn ocupados) y construye aqu cada
+ * `PathAsset`, para que el hilo principal solo tenga que entregarlo.
+ */
+void PathService::runBatch(Batch& batch) {
+	std::unique_ptr<Pathfinder> pathfinder;
+	{
+		std::lock_guard<EngineUtilities::SpinLock> lock(m_pathfinderLock);
+		if (!m_pathfinders.empty()) {
+			pathfinder = std::move(m_pathfinders.back());
+			m_pathfinders.pop_back();
+		}
+	}
+	if (!pathfinder) {
+		pathfinder = std::make_unique<Pathfinder>(m_grid.getCellCount());
+	}
+
+	for (Search& search : batch.searches) {
+		const std::uint32_t start = static_cast<std::uint32_t>(search.key >> 32);
+		const std::uint32_t goal = static_cast<std::uint32_t>(search.key);
+		search.path = pathfinder->findPath(m_grid, start, goal, search.cells) ? buildPath(search.cells) : PathAssetPtr();
+	}
+
+	std::lock_guard<EngineUtilities::SpinLock> lock(m_pathfinderLock);
+	m_pathfinders.push_back(std::move(pathfinder));
+}
+
+/**
+ * @brief Convierte las celdas de un camino en un recorrido abierto.
+ * @param cells Celdas, de inicio a destino.
+ *
+ * Solo conserva los centros de las celdas donde el camino cambia de direccin.
+ */
+PathAssetPtr PathService::buildPath(const std::vector<std::uint32_t>& cells) const {
+	std::vector<sf::Vector2f> points;
+	points.push_back(m_grid.cellCenter(cells.front()));
+	for (std::size_t i = 1; i + 1 < cells.size(); ++i) {
+		const std::int64_t before = static_cast<std::int64_t>(cells[i]) - cells[i - 1];
+		const std::int64_t after = static_cast<std::int64_t>(cells[i + 1]) - cells[i];
+		if (before != after) {
+			points.push_back(m_grid.cellCenter(cells[i]));
+		}
+	}
+	if (cells.size() > 1) {
+		points.push_back(m_grid.cellCenter(cells.back()));
+	}
+	return EngineUtilities::MakeShared<PathAsset>(std::move(points), false);
+}
+
+/**
+ * @brief Recoge los trabajos terminados y entrega sus caminos.
+ */
+void PathService::collect() {
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < m_inFlight.size(); ++i) {
+		std::unique_ptr<Batch>& batch = m_inFlight[i];
+		if (!batch->counter.isDone()) {
+			m_inFlight[kept++] = std::move(batch);
+			continue;
+		}
+
+		for (Search& search : batch->searches) {
+			++m_searches;
+			if (!search.path) ++m_failures;
+			insertCached(search.key, search.path);
+			deliver(search.key, search.path);
+		}
+		m_freeBatches.push_back(std::move(batch));
+	}
+	m_inFlight.resize(kept);
+}
+
+/**
+ * @brief Lanza hasta `m_searchBudget` bsquedas en trabajos de `SearchGrain`.
+ */
+void PathService::dispatch() {
+	const std::size_t count = std::min(m_queued.size(), m_searchBudget);
+	JobSystem& jobs = JobSystem::instance();
+	for (std::size_t begin = 0; begin < count; begin += SearchGrain) {
+		const std::size_t end = std::min(begin + SearchGrain, count);
+
+		std::unique_ptr<Batch> batch;
+		if (m_freeBatches.empty()) {
+			batch = std::make_unique<Batch>();
+		}
+		else {
+			batch = std::move(m_freeBatches.back());
+			m_freeBatches.pop_back();
+		}
+		batch->searches.resize(end - begin);
+		for (std::size_t i = begin; i < end; ++i) {
+			Search& search = batch->searches[i - begin];
+			search.key = m_queued[i];
+			search.path = PathAssetPtr();
+		}
+
+		Batch* job = batch.get();
+		jobs.schedule([this, job]() { runBatch(*job); }, &job->counter);
+		m_inFlight.push_back(std::move(batch));
+	}
+	m_queued.erase(m_queued.begin(), m_queued.begin() + count);
+}
+
+/**
+ * @brief Espera a que terminen todos los trabajos lanzados, sin recogerlos.
+ */
+void PathService::waitInFlight() {
+	JobSystem& jobs = JobSystem::instance();
+	for (const std::unique_ptr<Batch>& batch : m_inFlight) {
+		jobs.wait(batch->counter);
+	}
+}
+
+/**
+ * @brief Anota a un actor como interesado en un par y encola el par si es nuevo.
+ * @param request Peticin con la clave ya calculada.
+ */
+void PathService::enqueue(const Request& request) {
+	std::vector<ActorHandle>& waiting = m_waiting[request.key];
+	if (waiting.empty()) {
+		m_queued.push_back(request.key); // Nadie ms lo pidi: hay que buscarlo.
+	}
+	waiting.push_back(request.agent);
+}
+
+/**
+ * @brief Entrega un camino a los actores que todava lo esperan.
+ * @param key Par de celdas del camino.
+ * @param path Camino, o vaco si no hay.
+ */
+void PathService::deliver(std::uint64_t key, const PathAssetPtr& path) {
+	auto waiting = m_waiting.find(key);
+	if (waiting == m_waiting.end()) return;
+
+	for (ActorHandle agent : waiting->second) {
+		auto request = m_requests.find(handleKey(agent));
+		if (request == m_requests.end() || request->second.key != key) continue; // Pidi otro camino despus.
+		m_requests.erase(request);
+
+		Actor* actor = m_actors.get(agent);
+		PathFollow* follow = actor != nullptr ? actor->getComponentPtr<PathFollow>() : nullptr;
+		if (follow != nullptr) {
+			follow->setPath(path);
+		}
+	}
+	m_waiting.erase(waiting);
+}
+
+/**
+ * @brief Busca un par en la cach y lo marca como el ms reciente.
+ * @return El camino guardado, o nullptr si el par no est.
+ */
+const PathAssetPtr* PathService::findCached(std::uint64_t key) {
+	auto found = m_cacheIndex.find(key);
+	if (found == m_cacheIndex.end()) return nullptr;
+	m_cache.splice(m_cache.begin(), m_cache, found->second);
+	return &found->second->path;
+}
+
+/**
+ * @brief Guarda un camino en la cach, sacando el menos reciente si est llena.
+ */
+void PathService::insertCached(std::uint64_t key, const PathAssetPtr& path) {
+	if (m_cacheCapacity == 0) return;
+
+	auto found = m_cacheIndex.find(key);
+	if (found != m_cacheIndex.end()) {
+		found->second->path = path;
+		m_cache.splice(m_cache.begin(), m_cache, found->second);
+		return;
+	}
+	if (m_cache.size() >= m_cacheCapacity) {
+		m_cacheIndex.erase(m_cache.back().key);
+		m_cache.pop_back();
+	}
+	m_cache.push_front({ key, path });
+	m_cacheIndex.emplace(key, m_cache.begin());
+}
@@ -0,0 +1,151 @@
+#include "Pathfinder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	/// Costo de un paso diagonal.
+	constexpr float DiagonalCost = 1.41421356f;
+
+	/**
+	 * @brief Distancia octil entre dos celdas, en celdas.
+	 */
+	float octile(std::uint32_t a, std::uint32_t b, std::uint32_t width) {
+		const float dx = std::abs(static_cast<float>(a % width) - static_cast<float>(b % width));
+		const float dy = std::abs(static_cast<float>(a / width) - static_cast<float>(b / width));
+		return dx + dy + (DiagonalCost - 2.0f) * std::min(dx, dy);
+	}
+}
+
+/**
+ * @brief Constructor.
+ * @param cellCount Celdas de la rejilla ms grande que se va a usar.
+ */
+Pathfinder::Pathfinder(std::size_t cellCount) : m_nodes(cellCount) {
+	m_open.reserve(cellCount);
+}
+
+/**
+ * @brief Busca el camino ms corto entre dos celdas con A*.
+ * @param grid Rejilla de navegacin.
+ * @param start Celda de inicio.
+ * @param goal Celda de destino.
+ * @param cells Recibe las celdas del camino, de `start` a `goal`.
+ * @return false si no hay camino.
+ *
+ * Solo crece la memoria si la rejilla tiene ms celdas que las reservadas.
+ */
+bool Pathfinder::findPath(const NavGrid& grid, std::uint32_t start, std::uint32_t goal, std::vector<std::uint32_t>& cells) {
+	cells.clear();
+	m_expanded = 0;
+	const std::uint32_t cellCount = grid.getCellCount();
+	if (start >= cellCount || goal >= cellCount || !grid.isWalkable(goal)) {
+		return false;
+	}
+
+	if (m_nodes.size() < cellCount) {
+		m_nodes.resize(cellCount);
+	}
+	if (++m_generation == 0) {
+		// La generacin dio la vuelta: hay que limpiar de verdad una vez.
+		for (Node& node : m_nodes) node.generation = 0;
+		m_generation = 1;
+	}
+	m_open.clear();
+
+	const std::uint32_t width = grid.getWidth();
+	const std::uint32_t height = grid.getHeight();
+
+	Node& first = m_nodes[start];
+	first.cost = 0.0f;
+	first.parent = start;
+	first.generation = m_generation;
+	first.closed = false;
+	push({ octile(start, goal, width), 0.0f, start });
+
+	while (!m_open.empty()) {
+		const OpenEntry current = pop();
+		Node& node = m_nodes[current.cell];
+		if (node.closed || current.cost > node.cost) continue; // Entrada obsoleta.
+		node.closed = true;
+		++m_expanded;
+
+		if (current.cell == goal) {
+			for (std::uint32_t cell = goal; cell != start; cell = m_nodes[cell].parent) {
+				cells.push_back(cell);
+			}
+			cells.push_back(start);
+			std::reverse(cells.begin(), cells.end());
+			return true;
+		}
+
+		const int x = static_cast<int>(current.cell % width);
+		const int y = static_cast<int>(current.cell / width);
+		for (int dy = -1; dy <= 1; ++dy) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				if (dx == 0 && dy == 0) continue;
+				const int nx = x + dx;
+				const int ny = y + dy;
+				if (nx < 0 || ny < 0 || nx >= static_cast<int>(width) || ny >= static_cast<int>(height)) continue;
+
+				const std::uint32_t next = grid.toIndex(nx, ny);
+				if (!grid.isWalkable(next)) continue;
+				// En diagonal, las dos celdas que rodea deben estar libres.
+				if (dx != 0 && dy != 0 &&
+					(!grid.isWalkable(grid.toIndex(nx, y)) || !grid.isWalkable(grid.toIndex(x, ny)))) continue;
+
+				const float cost = node.cost + (dx != 0 && dy != 0 ? DiagonalCost : 1.0f);
+				Node& neighbour = m_nodes[next];
+				if (neighbour.generation != m_generation) {
+					neighbour.generation = m_generation;
+					neighbour.closed = false;
+				}
+				else if (neighbour.closed || cost >= neighbour.cost) {
+					continue;
+				}
+				neighbour.cost = cost;
+				neighbour.parent = current.cell;
+				push({ cost + octile(next, goal, width), cost, next });
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Agrega una entrada al montculo y la sube a su lugar.
+ */
+void Pathfinder::push(const OpenEntry& entry) {
+	std::size_t index = m_open.size();
+	m_open.push_back(entry);
+	while (index > 0) {
+		const std::size_t parent = (index - 1) / 2;
+		if (m_open[parent].priority <= entry.priority) break;
+		m_open[index] = m_open[parent];
+		index = parent;
+	}
+	m_open[index] = entry;
+}
+
+/**
+ * @brief Saca la entrada de menor prioridad y reacomoda el montculo.
+ */
+Pathfinder::OpenEntry Pathfinder::pop() {
+	const OpenEntry top = m_open.front();
+	const OpenEntry last = m_open.back();
+	m_open.pop_back();
+
+	const std::size_t count = m_open.size();
+	if (count > 0) {
+		std::size_t index = 0;
+		while (true) {
+			std::size_t child = index * 2 + 1;
+			if (child >= count) break;
+			if (child + 1 < count && m_open[child + 1].priority < m_open[child].priority) ++child;
+			if (last.priority <= m_open[child].priority) break;
+			m_open[index] = m_open[child];
+			index = child;
+		}
+		m_open[index] = last;
+	}
+	return top;
+}
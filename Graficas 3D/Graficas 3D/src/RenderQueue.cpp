@@ -0,0 +1,333 @@
+#include "RenderQueue.h"
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Agrega el relleno y el contorno de una forma a la cola.
+ * @param shape Forma a dibujar.
+ * @param order Capa, profundidad y modo de mezcla.
+ *
+ * El relleno se triangula como abanico desde el primer punto, igual que lo hace SFML
+ * con formas convexas. Las coordenadas de textura se calculan a partir de la caja
+ * local de la forma y de su `textureRect`. El contorno, si tiene grosor, se arma con
+ * un cuadriltero por lado, con las mismas esquinas que calcula `sf::Shape`, y nunca
+ * lleva textura. Relleno y contorno son dos dibujos distintos con la misma capa y
+ * profundidad.
+ */
+void RenderQueue::submit(const sf::Shape& shape, const DrawOrder& order) {
+	const std::size_t count = shape.getPointCount();
+	if (count < 3) {
+		return;
+	}
+	++m_submitted;
+
+	const sf::Transform& transform = shape.getTransform();
+	const sf::Texture* texture = shape.getTexture();
+
+	if (shape.getFillColor().a > 0 || texture != nullptr) {
+		const sf::FloatRect bounds = shape.getLocalBounds();
+		const sf::IntRect rect = shape.getTextureRect();
+		const sf::Color color = shape.getFillColor();
+
+		auto makeVertex = [&](const sf::Vector2f& point) {
+			sf::Vector2f texCoords;
+			if (texture != nullptr) {
+				const float u = bounds.width > 0.0f ? (point.x - bounds.left) / bounds.width : 0.0f;
+				const float v = bounds.height > 0.0f ? (point.y - bounds.top) / bounds.height : 0.0f;
+				texCoords = sf::Vector2f(rect.left + rect.width * u, rect.top + rect.height * v);
+			}
+			return sf::Vertex(transform.transformPoint(point), color, texCoords);
+		};
+
+		beginItem(texture, order);
+		const sf::Vertex first = makeVertex(shape.getPoint(0));
+		sf::Vertex previous = makeVertex(shape.getPoint(1));
+		for (std::size_t i = 2; i < count; ++i) {
+			const sf::Vertex current = makeVertex(shape.getPoint(i));
+			m_vertices.push_back(first);
+			m_vertices.push_back(previous);
+			m_vertices.push_back(current);
+			previous = current;
+		}
+		endItem();
+	}
+
+	const float thickness = shape.getOutlineThickness();
+	if (thickness != 0.0f && shape.getOutlineColor().a > 0) {
+		const sf::Color color = shape.getOutlineColor();
+		beginItem(nullptr, order);
+
+		// Normal unitaria de la arista a->b.
+		auto edgeNormal = [](const sf::Vector2f& a, const sf::Vector2f& b) {
+			sf::Vector2f normal(a.y - b.y, b.x - a.x);
+			const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+			return length > 0.0f ? normal / length : normal;
+		};
+
+		// Centro de la caja de los puntos, para orientar las normales hacia afuera.
+		sf::Vector2f low = shape.getPoint(0);
+		sf::Vector2f high = low;
+		for (std::size_t i = 1; i < count; ++i) {
+			const sf::Vector2f point = shape.getPoint(i);
+			low.x = std::min(low.x, point.x);
+			low.y = std::min(low.y, point.y);
+			high.x = std::max(high.x, point.x);
+			high.y = std::max(high.y, point.y);
+		}
+		const sf::Vector2f center = (low + high) * 0.5f;
+
+		// Igual que sf::Shape: cada punto se desplaza por la bisectriz de sus dos aristas.
+		auto outlinePoint = [&](std::size_t i) {
+			const sf::Vector2f p0 = shape.getPoint(i == 0 ? count - 1 : i - 1);
+			const sf::Vector2f p1 = shape.getPoint(i);
+			const sf::Vector2f p2 = shape.getPoint((i + 1) % count);
+			sf::Vector2f n1 = edgeNormal(p0, p1);
+			sf::Vector2f n2 = edgeNormal(p1, p2);
+			const sf::Vector2f inward = center - p1;
+			if (n1.x * inward.x + n1.y * inward.y > 0.0f) n1 = -n1;
+			if (n2.x * inward.x + n2.y * inward.y > 0.0f) n2 = -n2;
+			const float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+			const sf::Vector2f normal = (n1 + n2) / factor;
+			return transform.transformPoint(p1 + normal * thickness);
+		};
+
+		const sf::Vertex firstInner(transform.transformPoint(shape.getPoint(0)), color);
+		const sf::Vertex firstOuter(outlinePoint(0), color);
+		sf::Vertex inner = firstInner;
+		sf::Vertex outer = firstOuter;
+		for (std::size_t i = 1; i <= count; ++i) {
+			const sf::Vertex nextInner = i < count ? sf::Vertex(transform.transformPoint(shape.getPoint(i)), color) : firstInner;
+			const sf::Vertex nextOuter = i < count ? sf::Vertex(outlinePoint(i), color) : firstOuter;
+			m_vertices.push_back(inner);
+			m_vertices.push_back(outer);
+			m_vertices.push_back(nextInner);
+			m_vertices.push_back(nextInner);
+			m_vertices.push_back(outer);
+			m_vertices.push_back(nextOuter);
+			inner = nextInner;
+			outer = nextOuter;
+		}
+		endItem();
+	}
+}
+
+/**
+ * @brief Agrega una copia de una geometra compartida a la cola.
+ * @param mesh Geometra en espacio local.
+ * @param transform Transformacin de la copia.
+ * @param color Color de relleno de la copia.
+ * @param order Capa, profundidad y modo de mezcla.
+ */
+void RenderQueue::submit(const ShapeMesh& mesh, const sf::Transform& transform, const sf::Color& color,
+                         const DrawOrder& order) {
+	if (mesh.triangles.empty() || color.a == 0) {
+		return;
+	}
+	++m_submitted;
+
+	beginItem(nullptr, order);
+	for (const sf::Vector2f& point : mesh.triangles) {
+		m_vertices.push_back(sf::Vertex(transform.transformPoint(point), color));
+	}
+	endItem();
+}
+
+/**
+ * @brief Ordena, agrupa y dibuja todo lo pendiente, y vaca la cola.
+ * @param target Destino de dibujo.
+ */
+void RenderQueue::flush(sf::RenderTarget& target) {
+	buildBatches();
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		const Batch& batch = m_batches[i];
+		sf::RenderStates states(m_blendModes[batch.blendIndex]);
+		states.texture = batch.texture;
+		target.draw(batch.vertices, states);
+	}
+	clear();
+}
+
+/**
+ * @brief Ordena, agrupa y manda todo lo pendiente al rasterizador por CPU, y vaca la cola.
+ * @param rasterizer Rasterizador destino.
+ *
+ * Cada lote es una llamada a `drawTriangles`. El rasterizador no muestrea texturas.
+ */
+void RenderQueue::flush(SoftwareRasterizer& rasterizer) {
+	buildBatches();
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		const Batch& batch = m_batches[i];
+		rasterizer.drawTriangles(&batch.vertices[0], batch.vertices.getVertexCount(), m_blendModes[batch.blendIndex]);
+	}
+	clear();
+}
+
+/**
+ * @brief Ordena los dibujos pendientes y arma los lotes.
+ *
+ * Despus de ordenar, cada dibujo se une al lote anterior si comparte textura y modo
+ * de mezcla; si no, abre un lote nuevo. Cada lote es una llamada de dibujo.
+ */
+void RenderQueue::buildBatches() {
+	m_lastSubmitted = m_submitted;
+	m_batchCount = 0;
+	if (m_items.empty()) {
+		m_lastDrawCalls = 0;
+		return;
+	}
+
+	sortItems();
+
+	for (std::uint32_t index : m_order) {
+		const DrawItem& item = m_items[index];
+		Batch* batch = m_batchCount > 0 ? &m_batches[m_batchCount - 1] : nullptr;
+		if (batch == nullptr || batch->texture != item.texture || batch->blendIndex != item.blendIndex) {
+			if (m_batchCount == m_batches.size()) {
+				m_batches.emplace_back();
+			}
+			batch = &m_batches[m_batchCount++];
+			batch->texture = item.texture;
+			batch->blendIndex = item.blendIndex;
+			batch->vertices.clear();
+		}
+
+		const std::size_t base = batch->vertices.getVertexCount();
+		batch->vertices.resize(base + item.vertexCount);
+		for (std::uint32_t i = 0; i < item.vertexCount; ++i) {
+			batch->vertices[base + i] = m_vertices[item.firstVertex + i];
+		}
+	}
+	m_lastDrawCalls = m_batchCount;
+}
+
+/**
+ * @brief Descarta los dibujos pendientes sin dibujarlos.
+ *
+ * Los buffers se vacan pero conservan su memoria.
+ */
+void RenderQueue::clear() {
+	m_vertices.clear();
+	m_items.clear();
+	m_submitted = 0;
+}
+
+/**
+ * @brief Arma la clave de orden de un dibujo.
+ * @param layer Capa.
+ * @param blendIndex ndice del modo de mezcla (4 bits).
+ * @param textureIndex ndice de la textura (20 bits, 0 = sin textura).
+ * @param depth Profundidad.
+ * @return La clave; comparar claves como enteros da el orden de dibujo.
+ *
+ * Para que la profundidad se ordene como entero, a los positivos se les prende el bit
+ * de signo y a los negativos se les invierten todos los bits.
+ */
+std::uint64_t RenderQueue::makeSortKey(std::uint8_t layer, std::uint32_t blendIndex,
+                                       std::uint32_t textureIndex, float depth) {
+	std::uint32_t depthBits = 0;
+	std::memcpy(&depthBits, &depth, sizeof(depthBits));
+	depthBits = (depthBits & 0x80000000u) ? ~depthBits : (depthBits | 0x80000000u);
+
+	return (static_cast<std::uint64_t>(layer) << 56) |
+		(static_cast<std::uint64_t>(std::min<std::uint32_t>(blendIndex, 0xF)) << 52) |
+		(static_cast<std::uint64_t>(std::min<std::uint32_t>(textureIndex, 0xFFFFF)) << 32) |
+		depthBits;
+}
+
+/**
+ * @brief Abre un dibujo con los vrtices que se agreguen a continuacin.
+ * @param texture Textura del dibujo, o nullptr.
+ * @param order Capa, profundidad y modo de mezcla.
+ */
+void RenderQueue::beginItem(const sf::Texture* texture, const DrawOrder& order) {
+	DrawItem item;
+	item.texture = texture;
+	item.blendIndex = blendIndex(order.blendMode);
+	item.key = makeSortKey(order.layer, item.blendIndex, textureIndex(texture), order.depth);
+	item.firstVertex = static_cast<std::uint32_t>(m_vertices.size());
+	m_items.push_back(item);
+}
+
+/**
+ * @brief Cierra el dibujo abierto; lo descarta si no tiene vrtices.
+ */
+void RenderQueue::endItem() {
+	DrawItem& item = m_items.back();
+	item.vertexCount = static_cast<std::uint32_t>(m_vertices.size()) - item.firstVertex;
+	if (item.vertexCount == 0) {
+		m_items.pop_back();
+	}
+}
+
+/**
+ * @brief Ordena `m_order` por clave con radix sort LSD de 8 bits por pasada.
+ *
+ * Son ocho pasadas de conteo, una por byte de la clave, empezando por el menos
+ * significativo; cada pasada es estable, as que el resultado tambin. Se saltan las
+ * pasadas en que todas las claves tienen el mismo byte, que es lo normal en los bytes
+ * de capa y mezcla.
+ */
+void RenderQueue::sortItems() {
+	const std::size_t count = m_items.size();
+	m_order.resize(count);
+	m_scratch.resize(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		m_order[i] = static_cast<std::uint32_t>(i);
+	}
+
+	for (unsigned shift = 0; shift < 64; shift += 8) {
+		std::size_t histogram[256] = {};
+		for (std::uint32_t index : m_order) {
+			++histogram[(m_items[index].key >> shift) & 0xFF];
+		}
+		if (histogram[(m_items[m_order[0]].key >> shift) & 0xFF] == count) {
+			continue;
+		}
+
+		std::size_t offset = 0;
+		for (std::size_t& bucket : histogram) {
+			const std::size_t size = bucket;
+			bucket = offset;
+			offset += size;
+		}
+		for (std::uint32_t index : m_order) {
+			m_scratch[histogram[(m_items[index].key >> shift) & 0xFF]++] = index;
+		}
+		m_order.swap(m_scratch);
+	}
+}
+
+/**
+ * @brief Obtiene el ndice de una textura para la clave.
+ * @param texture Textura, o nullptr.
+ * @return 0 para nullptr; si no, un ndice que se asigna la primera vez que se ve la textura.
+ */
+std::uint32_t RenderQueue::textureIndex(const sf::Texture* texture) {
+	if (texture == nullptr) {
+		return 0;
+	}
+	auto it = m_textureIds.find(texture);
+	if (it != m_textureIds.end()) {
+		return it->second;
+	}
+	const std::uint32_t index = static_cast<std::uint32_t>(m_textureIds.size()) + 1;
+	m_textureIds.emplace(texture, index);
+	return index;
+}
+
+/**
+ * @brief Obtiene el ndice de un modo de mezcla para la clave.
+ * @param blendMode Modo de mezcla.
+ * @return Posicin del modo en `m_blendModes`; se agrega si es nuevo.
+ */
+std::uint32_t RenderQueue::blendIndex(const sf::BlendMode& blendMode) {
+	for (std::size_t i = 0; i < m_blendModes.size(); ++i) {
+		if (m_blendModes[i] == blendMode) {
+			return static_cast<std::uint32_t>(i);
+		}
+	}
+	m_blendModes.push_back(blendMode);
+	return static_cast<std::uint32_t>(m_blendModes.size() - 1);
+}
@@ -0,0 +1,60 @@
+#include "SeekSystem.h"
+#include "SteeringKernels.h"
+
+/**
+ * @brief Constructor.
+ * @param actors Registro de actores de la aplicacin.
+ * @param slowingRadius Distancia desde la que los actores frenan; 0 para no frenar.
+ * @param range Distancia al objetivo a la que un actor ya no se mueve.
+ */
+SeekSystem::SeekSystem(EntityRegistry& actors, float slowingRadius, float range)
+	: System("SeekSystem"), m_actors(actors), m_slowingRadius(slowingRadius), m_range(range) {
+	reads<SeekTarget>();
+	writes<ShapeFactory>();
+}
+
+/**
+ * @brief Mueve a todos los actores hacia su objetivo.
+ * @param world World de la aplicacin (no se usa).
+ * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+ *
+ * Los kernels corren repartidos en el `JobSystem`; la escritura final es en serie
+ * porque actualiza el ndice espacial del registro.
+ */
+void SeekSystem::update(World& world, float deltaTime) {
+	m_shapes.clear();
+	m_targetX.clear();
+	m_targetY.clear();
+	m_speed.clear();
+	for (Entity* entity : m_actors.getQueries().view<SeekTarget, ShapeFactory>()) {
+		if (!entity->getIsActive()) continue;
+
+		const SeekTarget* seek = entity->getComponentPtr<SeekTarget>();
+		m_shapes.push_back(entity->getComponentPtr<ShapeFactory>());
+		m_targetX.push_back(seek->getTarget().x);
+		m_targetY.push_back(seek->getTarget().y);
+		m_speed.push_back(seek->getSpeed());
+	}
+	if (m_shapes.empty()) return;
+
+	const std::size_t count = m_shapes.size();
+	m_positionX.resize(count);
+	m_positionY.resize(count);
+	SteeringKernels::gatherPositions(m_shapes.data(), count, m_positionX.data(), m_positionY.data());
+
+	SteeringStreams streams;
+	streams.positionX = m_positionX.data();
+	streams.positionY = m_positionY.data();
+	streams.targetX = m_targetX.data();
+	streams.targetY = m_targetY.data();
+	streams.maxSpeed = m_speed.data();
+	streams.count = count;
+	if (m_slowingRadius > 0.0f) {
+		SteeringKernels::parallelArrive(streams, deltaTime, m_slowingRadius, m_range);
+	}
+	else {
+		SteeringKernels::parallelSeek(streams, deltaTime, m_range);
+	}
+
+	SteeringKernels::scatterPositions(m_shapes.data(), count, m_positionX.data(), m_positionY.data());
+}
@@ -1,42 +1,48 @@
 #include "ShapeFactory.h"
+#include "SteeringKernels.h"
+
+/**
+ * @brief Destructor de ShapeFactory.
+ *
+ * Saca la forma de su ndice espacial, si tiene uno.
+ */
+ShapeFactory::~ShapeFactory() {
+	detachSpatialIndex();
+}
 
 /**
  * @brief Crea una forma basada en el tipo especificado.
  *
- * Esta funcin inicializa un nuevo objeto de forma (crculo, rectngulo o tringulo)
- * dependiendo del tipo proporcionado. Establece el color de llenado predeterminado
- * como blanco.
+ * Esta funcin obtiene del cach de geometras la forma (crculo, rectngulo o
+ * tringulo) que corresponde al tipo proporcionado; si otra instancia ya pidi la
+ * misma, se comparte en lugar de crear otra. Establece el color de llenado
+ * predeterminado como blanco. La transformacin actual se conserva.
  *
  * @param shapeType Tipo de forma a crear.
- * @return Un puntero a la forma creada, o nullptr si el tipo es EMPTY.
+ * @return Un puntero a la geometra creada, o nullptr si el tipo es EMPTY.
  */
-sf::Shape* ShapeFactory::createShape(ShapeType shapeType) {
+const ShapeMesh* ShapeFactory::createShape(ShapeType shapeType) {
 	m_shapeType = shapeType; // Establece el tipo de forma.
+	m_fillColor = sf::Color::White; // Establece el color de llenado.
 	switch (shapeType) {
-	case EMPTY: {
-		return nullptr; // Devuelve nullptr si el tipo es EMPTY.
-	}
 	case CIRCLE: {
-		sf::CircleShape* circle = new sf::CircleShape(10.0f); // Crea un crculo de radio 10.
-		circle->setFillColor(sf::Color::White); // Establece el color de llenado.
-		m_shape = circle; // Almacena la forma creada.
-		return circle; // Devuelve el puntero al crculo.
+		m_mesh = GeometryCache::instance().getCircle(10.0f); // Crculo de radio 10.
+		break;
 	}
 	case RECTANGLE: {
-		sf::RectangleShape* rectangle = new sf::RectangleShape(sf::Vector2(100.0f, 50.0f)); // Crea un rectngulo.
-		rectangle->setFillColor(sf::Color::White); // Establece el color de llenado.
-		m_shape = rectangle; // Almacena la forma creada.
-		return rectangle; // Devuelve el puntero al rectngulo.
+		m_mesh = GeometryCache::instance().getRectangle(sf::Vector2f(100.0f, 50.0f)); // Rectngulo de 100x50.
+		break;
 	}
 	case TRIANGLE: {
-		sf::CircleShape* triangle = new sf::CircleShape(50.0f, 3); // Crea un tringulo con radio 50.
-		triangle->setFillColor(sf::Color::White); // Establece el color de llenado.
-		m_shape = triangle; // Almacena la forma creada.
-		return triangle; // Devuelve el puntero al tringulo.
+		m_mesh = GeometryCache::instance().getCircle(50.0f, 3); // Tringulo con radio 50.
+		break;
 	}
 	default:
-		return nullptr; // Devuelve nullptr si el tipo no es vlido.
+		m_mesh = ShapeMeshPtr(); // Sin geometra si el tipo es EMPTY o no es vlido.
+		break;
 	}
+	updateBounds(); // La caja cambia con la geometra.
+	return m_mesh.get();
 }
 
 /**
@@ -48,7 +54,8 @@ sf::Shape* ShapeFactory::createShape(ShapeType shapeType) {
  * @param y Coordenada y de la posicin deseada.
  */
 void ShapeFactory::setPosition(float x, float y) {
-	m_shape->setPosition(x, y); // Establece la posicin de la forma.
+	m_transformable.setPosition(x, y); // Establece la posicin de la forma.
+	updateBounds();
 }
 
 /**
@@ -59,7 +66,8 @@ void ShapeFactory::setPosition(float x, float y) {
  * @param position Vector que contiene las coordenadas de la posicin deseada.
  */
 void ShapeFactory::setPosition(const sf::Vector2f& position) {
-	m_shape->setPosition(position); // Establece la posicin de la forma.
+	m_transformable.setPosition(position); // Establece la posicin de la forma.
+	updateBounds();
 }
 
 /**
@@ -70,7 +78,7 @@ void ShapeFactory::setPosition(const sf::Vector2f& position) {
  * @param color Color a establecer como nuevo color de llenado.
  */
 void ShapeFactory::setFillColor(const sf::Color& color) {
-	m_shape->setFillColor(color); // Cambia el color de llenado de la forma.
+	m_fillColor = color; // Cambia el color de llenado de la forma.
 }
 
 /**
@@ -78,7 +86,8 @@ void ShapeFactory::setFillColor(const sf::Color& color) {
  *
  * Esta funcin calcula la direccin hacia la posicin objetivo y mueve la forma
  * en esa direccin si la distancia a la posicin objetivo es mayor que el rango
- * especificado.
+ * especificado. Es un lote de un solo agente de `SteeringKernels::seekBatch`, as que
+ * se mueve igual que los agentes que se actualizan por lotes.
  *
  * @param targetPosition Posicin objetivo a la que se desea mover la forma.
  * @param speed Velocidad a la que se mover la forma.
@@ -86,18 +95,89 @@ void ShapeFactory::setFillColor(const sf::Color& color) {
  * @param range Rango dentro del cual la forma no se mover hacia el objetivo.
  */
 void ShapeFactory::Seek(const sf::Vector2f& targetPosition, float speed, float deltaTime, float range) {
-	// Obtener la posicin actual de la forma.
-	sf::Vector2f shapePosition = m_shape->getPosition();
+	sf::Vector2f position = m_transformable.getPosition();
 
-	// Calcular la direccin desde la forma hacia el objetivo.
-	sf::Vector2f direction = targetPosition - shapePosition;
+	SteeringStreams streams;
+	streams.positionX = &position.x;
+	streams.positionY = &position.y;
+	streams.targetX = &targetPosition.x;
+	streams.targetY = &targetPosition.y;
+	streams.maxSpeed = &speed;
+	streams.count = 1;
+	SteeringKernels::seekBatch(streams, deltaTime, range);
 
-	// Calcular la distancia al objetivo.
-	float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	// Si la distancia era mayor que el rango, la forma se movi.
+	if (position != m_transformable.getPosition()) {
+		m_transformable.setPosition(position);
+		updateBounds();
+	}
+}
 
-	// Si la distancia es mayor que el rango, mover la forma hacia el objetivo.
-	if (length > range) {
-		direction /= length; // Normaliza la direccin.
-		m_shape->move(direction * speed * deltaTime); // Mueve la forma en la direccin calculada.
+/**
+ * @brief Obtiene la caja de la forma en espacio de mundo.
+ *
+ * Transforma la caja local de la geometra compartida con la transformacin
+ * de esta forma.
+ *
+ * @return La caja, o un rectngulo vaco si no se ha creado una forma.
+ */
+sf::FloatRect ShapeFactory::getGlobalBounds() const {
+	if (!m_mesh) {
+		return sf::FloatRect();
+	}
+	return m_transformable.getTransform().transformRect(m_mesh->bounds);
+}
+
+/**
+ * @brief Conecta la forma a un ndice espacial.
+ *
+ * Si ya estaba en otro ndice, primero sale de l.
+ *
+ * @param tree rbol donde registrar la caja de la forma.
+ * @param userData Dato que devuelven las consultas al rbol.
+ */
+void ShapeFactory::attachSpatialIndex(AABBTree* tree, void* userData) {
+	detachSpatialIndex();
+	m_spatialIndex = tree;
+	m_spatialUserData = userData;
+	updateBounds();
+}
+
+/**
+ * @brief Saca la forma de su ndice espacial, si tiene uno.
+ */
+void ShapeFactory::detachSpatialIndex() {
+	if (m_spatialIndex != nullptr && m_proxyId != AABBTree::NullNode) {
+		m_spatialIndex->destroyProxy(m_proxyId);
+	}
+	m_spatialIndex = nullptr;
+	m_spatialUserData = nullptr;
+	m_proxyId = AABBTree::NullNode;
+}
+
+/**
+ * @brief Actualiza la caja de la forma en su ndice espacial.
+ *
+ * Una forma sin geometra no tiene proxy; se crea cuando se le asigna una y se
+ * elimina si se le quita.
+ */
+void ShapeFactory::updateBounds() {
+	if (m_spatialIndex == nullptr) {
+		return;
+	}
+	if (!m_mesh) {
+		if (m_proxyId != AABBTree::NullNode) {
+			m_spatialIndex->destroyProxy(m_proxyId);
+			m_proxyId = AABBTree::NullNode;
+		}
+		return;
+	}
+
+	const sf::FloatRect bounds = getGlobalBounds();
+	if (m_proxyId == AABBTree::NullNode) {
+		m_proxyId = m_spatialIndex->createProxy(bounds, m_spatialUserData);
+	}
+	else {
+		m_spatialIndex->moveProxy(m_proxyId, bounds);
 	}
 }
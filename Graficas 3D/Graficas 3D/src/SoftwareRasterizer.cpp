@@ -0,0 +1,435 @@
+#include "SoftwareRasterizer.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GALVAN_RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Crea el framebuffer.
+ * @param width Ancho en pxeles.
+ * @param height Alto en pxeles.
+ */
+void SoftwareRasterizer::create(unsigned width, unsigned height) {
+	m_width = width;
+	m_height = height;
+	m_tilesX = (width + TileSize - 1) / TileSize;
+	m_tilesY = (height + TileSize - 1) / TileSize;
+	m_pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+	m_triangles.clear();
+	m_bins.assign(static_cast<std::size_t>(m_tilesX) * m_tilesY, std::vector<std::uint32_t>());
+	m_view = sf::View(sf::FloatRect(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)));
+}
+
+/**
+ * @brief Cambia la vista con que se pasan las coordenadas de mundo a pxeles.
+ *
+ * Antes rasteriza lo pendiente, que se prepar con la vista anterior.
+ */
+void SoftwareRasterizer::setView(const sf::View& view) {
+	resolve();
+	m_view = view;
+}
+
+/**
+ * @brief Obtiene el rectngulo de mundo que cubre la vista actual.
+ * @return La caja de la vista; si est rotada, la caja que la contiene.
+ */
+sf::FloatRect SoftwareRasterizer::getViewBounds() const {
+	const float angle = m_view.getRotation() * 3.141592654f / 180.0f;
+	const float cosine = std::cos(angle);
+	const float sine = std::sin(angle);
+	const sf::Vector2f half = m_view.getSize() * 0.5f;
+	const sf::Vector2f center = m_view.getCenter();
+
+	const float extentX = std::abs(cosine * half.x) + std::abs(sine * half.y);
+	const float extentY = std::abs(sine * half.x) + std::abs(cosine * half.y);
+	return sf::FloatRect(center.x - extentX, center.y - extentY, extentX * 2.0f, extentY * 2.0f);
+}
+
+/**
+ * @brief Llena el framebuffer con un color.
+ * @param color Color de fondo.
+ */
+void SoftwareRasterizer::clear(const sf::Color& color) {
+	resolve();
+	for (std::size_t i = 0; i < m_pixels.size(); i += 4) {
+		m_pixels[i + 0] = color.r;
+		m_pixels[i + 1] = color.g;
+		m_pixels[i + 2] = color.b;
+		m_pixels[i + 3] = color.a;
+	}
+}
+
+/**
+ * @brief Prepara y reparte en tiles una lista de tringulos.
+ * @param vertices Vrtices en coordenadas de mundo, tres por tringulo.
+ * @param count Nmero de vrtices; si no es mltiplo de 3, los sobrantes se ignoran.
+ * @param blendMode Modo de mezcla.
+ */
+void SoftwareRasterizer::drawTriangles(const sf::Vertex* vertices, std::size_t count, const sf::BlendMode& blendMode) {
+	const BlendOp blend = toBlendOp(blendMode);
+	for (std::size_t i = 0; i + 2 < count; i += 3) {
+		setupTriangle(vertices[i], vertices[i + 1], vertices[i + 2], blend);
+	}
+}
+
+/**
+ * @brief Rasteriza en paralelo los tringulos pendientes.
+ *
+ * Cada tile es un trabajo del `JobSystem`; los tiles vacos no cuestan nada ms que
+ * revisar su lista. Sin tringulos pendientes las estadsticas quedan en cero, para no
+ * volver a contar el tiempo del `resolve` anterior.
+ */
+void SoftwareRasterizer::resolve() {
+	m_stats = RasterizerStats();
+	if (m_triangles.empty()) {
+		return;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	m_stats.triangles = m_triangles.size();
+	for (const std::vector<std::uint32_t>& bin : m_bins) {
+		m_stats.binnedTriangles += bin.size();
+		m_stats.tilesTouched += bin.empty() ? 0 : 1;
+	}
+
+	JobSystem::instance().parallelFor(m_bins.size(), 1, [this](std::size_t begin, std::size_t end) {
+		for (std::size_t tile = begin; tile < end; ++tile) {
+			rasterizeTile(tile);
+		}
+	});
+
+	m_triangles.clear();
+	for (std::vector<std::uint32_t>& bin : m_bins) {
+		bin.clear();
+	}
+
+	m_stats.resolveMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Obtiene los pxeles, RGBA de 8 bits por canal, fila por fila.
+ */
+const std::uint8_t* SoftwareRasterizer::getPixels() {
+	resolve();
+	return m_pixels.data();
+}
+
+/**
+ * @brief Obtiene el color de un pxel.
+ * @return El color, o transparente si el pxel est fuera del framebuffer.
+ */
+sf::Color SoftwareRasterizer::getPixel(unsigned x, unsigned y) {
+	if (x >= m_width || y >= m_height) {
+		return sf::Color(0, 0, 0, 0);
+	}
+	resolve();
+	const std::uint8_t* pixel = &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4];
+	return sf::Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+}
+
+/**
+ * @brief Guarda el framebuffer como imagen.
+ * @param path Ruta del archivo.
+ * @return true si se guard.
+ *
+ * Usa `sf::Image`, que no necesita GPU.
+ */
+bool SoftwareRasterizer::saveToFile(const std::string& path) {
+	if (m_width == 0 || m_height == 0) {
+		return false;
+	}
+	sf::Image image;
+	image.create(m_width, m_height, getPixels());
+	return image.saveToFile(path);
+}
+
+/**
+ * @brief Pasa un punto de mundo a pxeles con la vista actual.
+ *
+ * Hace lo mismo que `sf::RenderTarget::mapCoordsToPixel`: resta el centro, deshace la
+ * rotacin, escala de tamao de vista a tamao de viewport y suma el origen del viewport.
+ */
+sf::Vector2f SoftwareRasterizer::mapToPixel(const sf::Vector2f& point) const {
+	const float angle = m_view.getRotation() * 3.141592654f / 180.0f;
+	const float cosine = std::cos(angle);
+	const float sine = std::sin(angle);
+	const sf::Vector2f offset = point - m_view.getCenter();
+	const float rotatedX = cosine * offset.x + sine * offset.y;
+	const float rotatedY = -sine * offset.x + cosine * offset.y;
+
+	const sf::FloatRect viewport = m_view.getViewport();
+	const sf::Vector2f size = m_view.getSize();
+	return sf::Vector2f(
+		(rotatedX / size.x + 0.5f) * viewport.width * m_width + viewport.left * m_width,
+		(rotatedY / size.y + 0.5f) * viewport.height * m_height + viewport.top * m_height);
+}
+
+/**
+ * @brief Prepara un tringulo y lo agrega a los tiles que toca.
+ *
+ * Los vrtices se ajustan a 1/16 de pxel para que tringulos vecinos calculen
+ * exactamente las mismas aristas. Se aceptan ambos sentidos de giro, como SFML.
+ * Un tile solo recibe el tringulo si su caja toca el tile y ninguna arista deja
+ * el tile entero afuera.
+ */
+void SoftwareRasterizer::setupTriangle(const sf::Vertex& v0, const sf::Vertex& v1, const sf::Vertex& v2, BlendOp blend) {
+	if (m_width == 0 || m_height == 0) {
+		return;
+	}
+
+	const sf::Vertex* source[3] = { &v0, &v1, &v2 };
+	sf::Vector2f p[3];
+	for (int i = 0; i < 3; ++i) {
+		const sf::Vector2f pixel = mapToPixel(source[i]->position);
+		p[i] = sf::Vector2f(std::round(pixel.x * 16.0f) / 16.0f, std::round(pixel.y * 16.0f) / 16.0f);
+	}
+
+	// Doble del rea con signo; positiva si el interior queda del lado positivo de las aristas.
+	float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+	if (area == 0.0f || !std::isfinite(area)) {
+		return;
+	}
+	if (area < 0.0f) {
+		std::swap(p[1], p[2]);
+		std::swap(source[1], source[2]);
+		area = -area;
+	}
+
+	Triangle triangle;
+	triangle.blend = blend;
+	triangle.invArea = 1.0f / area;
+	for (int i = 0; i < 3; ++i) {
+		// Arista opuesta al vrtice i, de a hacia b.
+		const sf::Vector2f& a = p[(i + 1) % 3];
+		const sf::Vector2f& b = p[(i + 2) % 3];
+		const float dx = b.x - a.x;
+		const float dy = b.y - a.y;
+		triangle.A[i] = -dy;
+		triangle.B[i] = dx;
+		triangle.C[i] = dy * a.x - dx * a.y;
+		triangle.topLeft[i] = (dy == 0.0f && dx > 0.0f) || dy < 0.0f;
+
+		const sf::Color& color = source[i]->color;
+		triangle.color[i][0] = color.r;
+		triangle.color[i][1] = color.g;
+		triangle.color[i][2] = color.b;
+		triangle.color[i][3] = color.a;
+	}
+
+	const float minX = std::min({ p[0].x, p[1].x, p[2].x });
+	const float minY = std::min({ p[0].y, p[1].y, p[2].y });
+	const float maxX = std::max({ p[0].x, p[1].x, p[2].x });
+	const float maxY = std::max({ p[0].y, p[1].y, p[2].y });
+	triangle.minX = std::max(0, static_cast<int>(std::floor(minX)));
+	triangle.minY = std::max(0, static_cast<int>(std::floor(minY)));
+	triangle.maxX = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::ceil(maxX)));
+	triangle.maxY = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::ceil(maxY)));
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+		return;
+	}
+
+	const std::uint32_t index = static_cast<std::uint32_t>(m_triangles.size());
+	m_triangles.push_back(triangle);
+
+	const int tileX0 = triangle.minX / static_cast<int>(TileSize);
+	const int tileY0 = triangle.minY / static_cast<int>(TileSize);
+	const int tileX1 = triangle.maxX / static_cast<int>(TileSize);
+	const int tileY1 = triangle.maxY / static_cast<int>(TileSize);
+	for (int ty = tileY0; ty <= tileY1; ++ty) {
+		for (int tx = tileX0; tx <= tileX1; ++tx) {
+			// Centros del primer y ltimo pxel del tile.
+			const float left = tx * static_cast<float>(TileSize) + 0.5f;
+			const float top = ty * static_cast<float>(TileSize) + 0.5f;
+			const float right = left + TileSize - 1.0f;
+			const float bottom = top + TileSize - 1.0f;
+
+			bool outside = false;
+			for (int i = 0; i < 3 && !outside; ++i) {
+				// Esquina del tile donde la arista es mayor.
+				const float x = triangle.A[i] > 0.0f ? right : left;
+				const float y = triangle.B[i] > 0.0f ? bottom : top;
+				outside = triangle.A[i] * x + triangle.B[i] * y + triangle.C[i] < 0.0f;
+			}
+			if (!outside) {
+				m_bins[static_cast<std::size_t>(ty) * m_tilesX + tx].push_back(index);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Rasteriza los tringulos de un tile.
+ * @param tileIndex ndice del tile, fila por fila.
+ *
+ * Recorre cada fila de la caja del tringulo dentro del tile en grupos de cuatro
+ * pxeles. Un pxel est cubierto si su centro queda del lado positivo de las tres
+ * aristas, o justo encima de una arista superior o izquierda. El color se interpola
+ * con las coordenadas baricntricas, que son las funciones de arista por 1/rea.
+ */
+void SoftwareRasterizer::rasterizeTile(std::size_t tileIndex) {
+	const std::vector<std::uint32_t>& bin = m_bins[tileIndex];
+	if (bin.empty()) {
+		return;
+	}
+
+	const int tileX = static_cast<int>(tileIndex % m_tilesX) * static_cast<int>(TileSize);
+	const int tileY = static_cast<int>(tileIndex / m_tilesX) * static_cast<int>(TileSize);
+	const int tileRight = std::min(tileX + static_cast<int>(TileSize), static_cast<int>(m_width)) - 1;
+	const int tileBottom = std::min(tileY + static_cast<int>(TileSize), static_cast<int>(m_height)) - 1;
+
+	for (std::uint32_t index : bin) {
+		const Triangle& tri = m_triangles[index];
+		const int x0 = std::max(tri.minX, tileX);
+		const int x1 = std::min(tri.maxX, tileRight);
+		const int y0 = std::max(tri.minY, tileY);
+		const int y1 = std::min(tri.maxY, tileBottom);
+
+#ifdef GALVAN_RASTER_SSE2
+		const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+		const __m128 zero = _mm_setzero_ps();
+		__m128 A[3], topLeft[3];
+		for (int i = 0; i < 3; ++i) {
+			A[i] = _mm_set1_ps(tri.A[i]);
+			topLeft[i] = tri.topLeft[i] ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+		}
+		const __m128 invArea = _mm_set1_ps(tri.invArea);
+#endif
+
+		for (int y = y0; y <= y1; ++y) {
+			const float py = y + 0.5f;
+			float rowC[3];
+			for (int i = 0; i < 3; ++i) {
+				rowC[i] = tri.B[i] * py + tri.C[i];
+			}
+			std::uint8_t* row = &m_pixels[(static_cast<std::size_t>(y) * m_width) * 4];
+
+			for (int x = x0; x <= x1; x += 4) {
+				float shade[4][4]; // [canal][carril]
+				int coverage = 0;  // Un bit por carril cubierto.
+
+#ifdef GALVAN_RASTER_SSE2
+				const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffset);
+				__m128 w[3];
+				__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (int i = 0; i < 3; ++i) {
+					w[i] = _mm_add_ps(_mm_mul_ps(A[i], px), _mm_set1_ps(rowC[i]));
+					const __m128 positive = _mm_cmpgt_ps(w[i], zero);
+					const __m128 onEdge = _mm_and_ps(_mm_cmpeq_ps(w[i], zero), topLeft[i]);
+					inside = _mm_and_ps(inside, _mm_or_ps(positive, onEdge));
+				}
+				coverage = _mm_movemask_ps(inside);
+				if (coverage == 0) {
+					continue;
+				}
+
+				const __m128 l0 = _mm_mul_ps(w[0], invArea);
+				const __m128 l1 = _mm_mul_ps(w[1], invArea);
+				const __m128 l2 = _mm_mul_ps(w[2], invArea);
+				for (int channel = 0; channel < 4; ++channel) {
+					const __m128 value = _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(l0, _mm_set1_ps(tri.color[0][channel])),
+						           _mm_mul_ps(l1, _mm_set1_ps(tri.color[1][channel]))),
+						_mm_mul_ps(l2, _mm_set1_ps(tri.color[2][channel])));
+					_mm_storeu_ps(shade[channel], value);
+				}
+#else
+				for (int lane = 0; lane < 4; ++lane) {
+					const float px = x + lane + 0.5f;
+					float w[3];
+					bool inside = true;
+					for (int i = 0; i < 3; ++i) {
+						w[i] = tri.A[i] * px + rowC[i];
+						inside = inside && (w[i] > 0.0f || (w[i] == 0.0f && tri.topLeft[i]));
+					}
+					if (!inside) {
+						continue;
+					}
+					coverage |= 1 << lane;
+					for (int channel = 0; channel < 4; ++channel) {
+						shade[channel][lane] = (w[0] * tri.color[0][channel] +
+							w[1] * tri.color[1][channel] +
+							w[2] * tri.color[2][channel]) * tri.invArea;
+					}
+				}
+				if (coverage == 0) {
+					continue;
+				}
+#endif
+
+				for (int lane = 0; lane < 4 && x + lane <= x1; ++lane) {
+					if (coverage & (1 << lane)) {
+						const float src[4] = { shade[0][lane], shade[1][lane], shade[2][lane], shade[3][lane] };
+						blendPixel(row + static_cast<std::size_t>(x + lane) * 4, src, tri.blend);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Mezcla un color sobre un pxel.
+ * @param dst Pxel RGBA del framebuffer.
+ * @param src Color RGBA (0-255) del fragmento.
+ * @param blend Modo de mezcla.
+ *
+ * Usa las mismas ecuaciones que los modos predefinidos de SFML.
+ */
+void SoftwareRasterizer::blendPixel(std::uint8_t* dst, const float src[4], BlendOp blend) {
+	auto store = [](float value) {
+		return static_cast<std::uint8_t>(std::min(255.0f, std::max(0.0f, value)) + 0.5f);
+	};
+	const float alpha = std::min(255.0f, std::max(0.0f, src[3])) / 255.0f;
+
+	switch (blend) {
+	case BLEND_NONE:
+		for (int c = 0; c < 4; ++c) {
+			dst[c] = store(src[c]);
+		}
+		break;
+	case BLEND_ADD:
+		for (int c = 0; c < 3; ++c) {
+			dst[c] = store(src[c] * alpha + dst[c]);
+		}
+		dst[3] = store(src[3] + dst[3]);
+		break;
+	case BLEND_MULTIPLY:
+		for (int c = 0; c < 4; ++c) {
+			dst[c] = store(src[c] * dst[c] / 255.0f);
+		}
+		break;
+	case BLEND_ALPHA:
+	default:
+		for (int c = 0; c < 3; ++c) {
+			dst[c] = store(src[c] * alpha + dst[c] * (1.0f - alpha));
+		}
+		dst[3] = store(src[3] + dst[3] * (1.0f - alpha));
+		break;
+	}
+}
+
+/**
+ * @brief Traduce un `sf::BlendMode` a un modo soportado.
+ */
+SoftwareRasterizer::BlendOp SoftwareRasterizer::toBlendOp(const sf::BlendMode& blendMode) {
+	if (blendMode == sf::BlendAlpha) {
+		return BLEND_ALPHA;
+	}
+	if (blendMode == sf::BlendAdd) {
+		return BLEND_ADD;
+	}
+	if (blendMode == sf::BlendMultiply) {
+		return BLEND_MULTIPLY;
+	}
+	if (blendMode == sf::BlendNone) {
+		return BLEND_NONE;
+	}
+	return BLEND_ALPHA;
+}
@@ -0,0 +1,285 @@
+#include "Steering.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	/// Agentes por trabajo al calcular las fuerzas del grupo.
+	constexpr std::size_t SteerGrain = 512;
+
+	float length(const sf::Vector2f& vector) {
+		return std::sqrt(vector.x * vector.x + vector.y * vector.y);
+	}
+
+	/**
+	 * @brief Vector unitario en la misma direccin, o cero si el vector es cero.
+	 */
+	sf::Vector2f normalize(const sf::Vector2f& vector) {
+		const float len = length(vector);
+		return len > 0.0f ? vector / len : sf::Vector2f();
+	}
+
+	/**
+	 * @brief Nmero pseudoaleatorio en [-1, 1] (xorshift de 32 bits).
+	 */
+	float randomBinomial(std::uint32_t& seed) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return static_cast<float>(seed & 0xFFFFFF) * (2.0f / 16777215.0f) - 1.0f;
+	}
+}
+
+/**
+ * @brief Recorta un vector a una longitud mxima.
+ */
+sf::Vector2f Steering::truncate(const sf::Vector2f& vector, float maxLength) {
+	const float len = length(vector);
+	return len > maxLength ? vector * (maxLength / len) : vector;
+}
+
+/**
+ * @brief Ir hacia un punto a velocidad mxima.
+ */
+sf::Vector2f Steering::seek(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                            const sf::Vector2f& target, float maxSpeed) {
+	return normalize(target - position) * maxSpeed - velocity;
+}
+
+/**
+ * @brief Alejarse de un punto; no hace nada ms all de `panicDistance`.
+ */
+sf::Vector2f Steering::flee(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                            const sf::Vector2f& threat, float maxSpeed, float panicDistance) {
+	const sf::Vector2f away = position - threat;
+	if (away.x * away.x + away.y * away.y > panicDistance * panicDistance) {
+		return sf::Vector2f();
+	}
+	return normalize(away) * maxSpeed - velocity;
+}
+
+/**
+ * @brief Ir hacia un punto frenando dentro de `slowingRadius`.
+ *
+ * La velocidad deseada baja linealmente con la distancia dentro del radio, as que el
+ * agente llega con velocidad cero en lugar de oscilar alrededor del objetivo.
+ */
+sf::Vector2f Steering::arrive(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                              const sf::Vector2f& target, float maxSpeed, float slowingRadius) {
+	const sf::Vector2f offset = target - position;
+	const float distance = length(offset);
+	if (distance <= 0.0f) {
+		return -velocity;
+	}
+	const float speed = slowingRadius > 0.0f ? maxSpeed * std::min(1.0f, distance / slowingRadius) : maxSpeed;
+	return offset * (speed / distance) - velocity;
+}
+
+/**
+ * @brief Ir hacia donde estar otro agente si sigue con la misma velocidad.
+ *
+ * Se adelanta el tiempo que tardara en llegar a su posicin actual a velocidad mxima.
+ */
+sf::Vector2f Steering::pursue(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                              const sf::Vector2f& quarryPosition, const sf::Vector2f& quarryVelocity, float maxSpeed) {
+	const float lookAhead = maxSpeed > 0.0f ? length(quarryPosition - position) / maxSpeed : 0.0f;
+	return seek(position, velocity, quarryPosition + quarryVelocity * lookAhead, maxSpeed);
+}
+
+/**
+ * @brief Alejarse de donde estar otro agente; no hace nada ms all de `panicDistance`.
+ *
+ * La distancia de pnico se mide a la posicin actual de la amenaza.
+ */
+sf::Vector2f Steering::evade(const sf::Vector2f& position, const sf::Vector2f& velocity,
+                             const sf::Vector2f& threatPosition, const sf::Vector2f& threatVelocity,
+                             float maxSpeed, float panicDistance) {
+	const float distance = length(threatPosition - position);
+	if (distance > panicDistance) {
+		return sf::Vector2f();
+	}
+	const float lookAhead = maxSpeed > 0.0f ? distance / maxSpeed : 0.0f;
+	const sf::Vector2f away = position - (threatPosition + threatVelocity * lookAhead);
+	return normalize(away) * maxSpeed - velocity;
+}
+
+/**
+ * @brief Deambular: seguir un punto que se mueve al azar sobre un crculo por delante.
+ */
+sf::Vector2f Steering::wander(const sf::Vector2f& velocity, WanderState& state,
+                              const SteeringParams& params, float deltaTime) {
+	state.angle += randomBinomial(state.seed) * params.wanderJitter * deltaTime;
+
+	sf::Vector2f heading = normalize(velocity);
+	if (heading == sf::Vector2f()) {
+		heading = sf::Vector2f(1.0f, 0.0f);
+	}
+	const sf::Vector2f displacement(std::cos(state.angle) * params.wanderRadius,
+	                                std::sin(state.angle) * params.wanderRadius);
+	return heading * params.wanderDistance + displacement;
+}
+
+/**
+ * @brief Agrega un agente.
+ * @return ndice del agente en el grupo.
+ *
+ * El ngulo y la semilla de Wander salen del ndice, as que dos grupos creados igual
+ * se mueven igual.
+ */
+std::size_t SteeringGroup::addAgent(const sf::Vector2f& position, const sf::Vector2f& velocity) {
+	const std::size_t index = size();
+	m_positionX.push_back(position.x);
+	m_positionY.push_back(position.y);
+	m_velocityX.push_back(velocity.x);
+	m_velocityY.push_back(velocity.y);
+	m_nextPositionX.push_back(position.x);
+	m_nextPositionY.push_back(position.y);
+	m_nextVelocityX.push_back(velocity.x);
+	m_nextVelocityY.push_back(velocity.y);
+
+	WanderState wander;
+	wander.seed = static_cast<std::uint32_t>(index) * 2654435761u + 1u;
+	wander.angle = randomBinomial(wander.seed) * 3.14159265f;
+	m_wander.push_back(wander);
+	return index;
+}
+
+/**
+ * @brief Elimina todos los agentes.
+ */
+void SteeringGroup::clear() {
+	m_positionX.clear();
+	m_positionY.clear();
+	m_velocityX.clear();
+	m_velocityY.clear();
+	m_nextPositionX.clear();
+	m_nextPositionY.clear();
+	m_nextVelocityX.clear();
+	m_nextVelocityY.clear();
+	m_wander.clear();
+}
+
+/**
+ * @brief Cambia los lmites y distancias.
+ *
+ * Las celdas de la rejilla miden lo mismo que el radio de bsqueda de vecinos, as que
+ * cada bsqueda toca a lo ms 3 x 3 celdas.
+ */
+void SteeringGroup::setParams(const SteeringParams& params) {
+	m_params = params;
+	m_grid.setCellSize(std::max(params.neighbourRadius, params.separationRadius));
+}
+
+void SteeringGroup::setQuarry(const sf::Vector2f& position, const sf::Vector2f& velocity) {
+	m_quarryPosition = position;
+	m_quarryVelocity = velocity;
+}
+
+void SteeringGroup::setThreat(const sf::Vector2f& position, const sf::Vector2f& velocity) {
+	m_threatPosition = position;
+	m_threatVelocity = velocity;
+}
+
+/**
+ * @brief Avanza la simulacin un paso.
+ * @param deltaTime Tiempo del paso, en segundos.
+ *
+ * La integracin es de Euler semi-implcita: primero la velocidad con la fuerza,
+ * recortada a `maxSpeed`, y luego la posicin con la velocidad nueva.
+ */
+void SteeringGroup::update(float deltaTime) {
+	const std::size_t count = size();
+	if (count == 0) {
+		return;
+	}
+
+	m_grid.build(m_positionX.data(), m_positionY.data(), count);
+
+	JobSystem::instance().parallelFor(count, SteerGrain, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			const sf::Vector2f force = steer(i, deltaTime);
+			const sf::Vector2f velocity = Steering::truncate(getVelocity(i) + force * deltaTime, m_params.maxSpeed);
+			m_nextVelocityX[i] = velocity.x;
+			m_nextVelocityY[i] = velocity.y;
+			m_nextPositionX[i] = m_positionX[i] + velocity.x * deltaTime;
+			m_nextPositionY[i] = m_positionY[i] + velocity.y * deltaTime;
+		}
+	});
+
+	m_positionX.swap(m_nextPositionX);
+	m_positionY.swap(m_nextPositionY);
+	m_velocityX.swap(m_nextVelocityX);
+	m_velocityY.swap(m_nextVelocityY);
+}
+
+/**
+ * @brief Suma con pesos los comportamientos de un agente, recortada a `maxForce`.
+ *
+ * Separation, Alignment y Cohesion se calculan en una sola consulta a la rejilla.
+ * Separation empuja lejos de cada vecino cercano con una fuerza inversa a la distancia;
+ * Alignment sigue la velocidad media de los vecinos y Cohesion va hacia su centro.
+ */
+sf::Vector2f SteeringGroup::steer(std::size_t index, float deltaTime) {
+	const SteeringParams& p = m_params;
+	const SteeringWeights& w = m_weights;
+	const sf::Vector2f position = getPosition(index);
+	const sf::Vector2f velocity = getVelocity(index);
+
+	sf::Vector2f force;
+	if (w.seek != 0.0f) {
+		force += Steering::seek(position, velocity, m_target, p.maxSpeed) * w.seek;
+	}
+	if (w.flee != 0.0f) {
+		force += Steering::flee(position, velocity, m_threatPosition, p.maxSpeed, p.panicDistance) * w.flee;
+	}
+	if (w.arrive != 0.0f) {
+		force += Steering::arrive(position, velocity, m_target, p.maxSpeed, p.slowingRadius) * w.arrive;
+	}
+	if (w.wander != 0.0f) {
+		force += Steering::wander(velocity, m_wander[index], p, deltaTime) * w.wander;
+	}
+	if (w.pursue != 0.0f) {
+		force += Steering::pursue(position, velocity, m_quarryPosition, m_quarryVelocity, p.maxSpeed) * w.pursue;
+	}
+	if (w.evade != 0.0f) {
+		force += Steering::evade(position, velocity, m_threatPosition, m_threatVelocity,
+			p.maxSpeed, p.panicDistance) * w.evade;
+	}
+
+	if (w.separation != 0.0f || w.alignment != 0.0f || w.cohesion != 0.0f) {
+		const float neighbourSquared = p.neighbourRadius * p.neighbourRadius;
+		const float separationSquared = p.separationRadius * p.separationRadius;
+		sf::Vector2f separation, heading, centre;
+		std::size_t neighbours = 0;
+
+		m_grid.queryRadius(position, std::max(p.neighbourRadius, p.separationRadius),
+			[&](std::uint32_t other, float distanceSquared) {
+				if (other == index) {
+					return;
+				}
+				if (distanceSquared < separationSquared && distanceSquared > 0.0f) {
+					separation += (position - getPosition(other)) / distanceSquared;
+				}
+				if (distanceSquared <= neighbourSquared) {
+					heading += getVelocity(other);
+					centre += getPosition(other);
+					++neighbours;
+				}
+			});
+
+		if (w.separation != 0.0f && separation != sf::Vector2f()) {
+			force += (normalize(separation) * p.maxSpeed - velocity) * w.separation;
+		}
+		if (neighbours > 0) {
+			if (w.alignment != 0.0f && heading != sf::Vector2f()) {
+				force += (normalize(heading) * p.maxSpeed - velocity) * w.alignment;
+			}
+			if (w.cohesion != 0.0f) {
+				const sf::Vector2f average = centre / static_cast<float>(neighbours);
+				force += Steering::seek(position, velocity, average, p.maxSpeed) * w.cohesion;
+			}
+		}
+	}
+
+	return Steering::truncate(force, p.maxForce);
+}
@@ -0,0 +1,215 @@
+#include "SteeringKernels.h"
+#include "ShapeFactory.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#define GALVAN_STEERING_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GALVAN_STEERING_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+	/// Agentes por bloque en las versiones paralelas; mltiplo de 8 para no partir registros.
+	constexpr std::size_t ParallelGrain = 4096;
+
+	/**
+	 * @brief Seek de un solo agente; lo usan las colas de los kernels SIMD.
+	 */
+	inline void seekOne(const SteeringStreams& s, std::size_t i, float deltaTime, float range) {
+		const float dx = s.targetX[i] - s.positionX[i];
+		const float dy = s.targetY[i] - s.positionY[i];
+		const float length = std::sqrt(dx * dx + dy * dy);
+		if (length > range) {
+			const float factor = s.maxSpeed[i] * deltaTime / length;
+			s.positionX[i] += dx * factor;
+			s.positionY[i] += dy * factor;
+		}
+	}
+
+	/**
+	 * @brief Arrive de un solo agente; lo usan las colas de los kernels SIMD.
+	 */
+	inline void arriveOne(const SteeringStreams& s, std::size_t i, float deltaTime, float invSlowingRadius, float range) {
+		const float dx = s.targetX[i] - s.positionX[i];
+		const float dy = s.targetY[i] - s.positionY[i];
+		const float length = std::sqrt(dx * dx + dy * dy);
+		if (length > range) {
+			const float scale = std::min(1.0f, length * invSlowingRadius);
+			const float step = std::min(s.maxSpeed[i] * deltaTime * scale, length);
+			const float factor = step / length;
+			s.positionX[i] += dx * factor;
+			s.positionY[i] += dy * factor;
+		}
+	}
+}
+
+/**
+ * @brief Nmero de agentes que procesa cada instruccin en esta compilacin.
+ */
+std::size_t SteeringKernels::simdWidth() {
+#if defined(GALVAN_STEERING_AVX)
+	return 8;
+#elif defined(GALVAN_STEERING_SSE2)
+	return 4;
+#else
+	return 1;
+#endif
+}
+
+/**
+ * @brief Mueve cada agente hacia su objetivo a velocidad mxima.
+ * @param streams Arreglos del lote.
+ * @param deltaTime Tiempo del paso.
+ * @param range Distancia a la que el agente ya no se mueve.
+ *
+ * Por registro: diferencia al objetivo, distancia con raz exacta, mscara de los que
+ * estn fuera de rango y desplazamiento `direccin * velocidad * dt`. Los carriles fuera
+ * de la mscara suman cero, as que no hace falta saltar.
+ */
+void SteeringKernels::seekBatch(const SteeringStreams& streams, float deltaTime, float range) {
+	std::size_t i = 0;
+
+#if defined(GALVAN_STEERING_AVX)
+	const __m256 dt = _mm256_set1_ps(deltaTime);
+	const __m256 rangeV = _mm256_set1_ps(range);
+	for (; i + 8 <= streams.count; i += 8) {
+		const __m256 px = _mm256_loadu_ps(streams.positionX + i);
+		const __m256 py = _mm256_loadu_ps(streams.positionY + i);
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(streams.targetX + i), px);
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(streams.targetY + i), py);
+		const __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+		const __m256 moving = _mm256_cmp_ps(length, rangeV, _CMP_GT_OQ);
+		const __m256 factor = _mm256_and_ps(moving,
+			_mm256_div_ps(_mm256_mul_ps(_mm256_loadu_ps(streams.maxSpeed + i), dt), length));
+		_mm256_storeu_ps(streams.positionX + i, _mm256_add_ps(px, _mm256_mul_ps(dx, factor)));
+		_mm256_storeu_ps(streams.positionY + i, _mm256_add_ps(py, _mm256_mul_ps(dy, factor)));
+	}
+#elif defined(GALVAN_STEERING_SSE2)
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 rangeV = _mm_set1_ps(range);
+	for (; i + 4 <= streams.count; i += 4) {
+		const __m128 px = _mm_loadu_ps(streams.positionX + i);
+		const __m128 py = _mm_loadu_ps(streams.positionY + i);
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(streams.targetX + i), px);
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(streams.targetY + i), py);
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+		const __m128 moving = _mm_cmpgt_ps(length, rangeV);
+		const __m128 factor = _mm_and_ps(moving,
+			_mm_div_ps(_mm_mul_ps(_mm_loadu_ps(streams.maxSpeed + i), dt), length));
+		_mm_storeu_ps(streams.positionX + i, _mm_add_ps(px, _mm_mul_ps(dx, factor)));
+		_mm_storeu_ps(streams.positionY + i, _mm_add_ps(py, _mm_mul_ps(dy, factor)));
+	}
+#endif
+
+	for (; i < streams.count; ++i) {
+		seekOne(streams, i, deltaTime, range);
+	}
+}
+
+/**
+ * @brief Mueve cada agente hacia su objetivo frenando al acercarse.
+ * @param streams Arreglos del lote.
+ * @param deltaTime Tiempo del paso.
+ * @param slowingRadius Distancia desde la que la velocidad baja linealmente hasta cero;
+ *        0 o menos para no frenar.
+ * @param range Distancia a la que el agente ya no se mueve.
+ *
+ * Sin radio de frenado el inverso es infinito, as que la escala siempre queda en 1 y
+ * solo se limita el paso a la distancia restante.
+ */
+void SteeringKernels::arriveBatch(const SteeringStreams& streams, float deltaTime, float slowingRadius, float range) {
+	const float invSlowingRadius = slowingRadius > 0.0f ? 1.0f / slowingRadius : std::numeric_limits<float>::infinity();
+	std::size_t i = 0;
+
+#if defined(GALVAN_STEERING_AVX)
+	const __m256 dt = _mm256_set1_ps(deltaTime);
+	const __m256 rangeV = _mm256_set1_ps(range);
+	const __m256 invSlow = _mm256_set1_ps(invSlowingRadius);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	for (; i + 8 <= streams.count; i += 8) {
+		const __m256 px = _mm256_loadu_ps(streams.positionX + i);
+		const __m256 py = _mm256_loadu_ps(streams.positionY + i);
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(streams.targetX + i), px);
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(streams.targetY + i), py);
+		const __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+		const __m256 moving = _mm256_cmp_ps(length, rangeV, _CMP_GT_OQ);
+		const __m256 scale = _mm256_min_ps(one, _mm256_mul_ps(length, invSlow));
+		const __m256 step = _mm256_min_ps(
+			_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(streams.maxSpeed + i), dt), scale), length);
+		const __m256 factor = _mm256_and_ps(moving, _mm256_div_ps(step, length));
+		_mm256_storeu_ps(streams.positionX + i, _mm256_add_ps(px, _mm256_mul_ps(dx, factor)));
+		_mm256_storeu_ps(streams.positionY + i, _mm256_add_ps(py, _mm256_mul_ps(dy, factor)));
+	}
+#elif defined(GALVAN_STEERING_SSE2)
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 rangeV = _mm_set1_ps(range);
+	const __m128 invSlow = _mm_set1_ps(invSlowingRadius);
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= streams.count; i += 4) {
+		const __m128 px = _mm_loadu_ps(streams.positionX + i);
+		const __m128 py = _mm_loadu_ps(streams.positionY + i);
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(streams.targetX + i), px);
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(streams.targetY + i), py);
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+		const __m128 moving = _mm_cmpgt_ps(length, rangeV);
+		const __m128 scale = _mm_min_ps(one, _mm_mul_ps(length, invSlow));
+		const __m128 step = _mm_min_ps(
+			_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(streams.maxSpeed + i), dt), scale), length);
+		const __m128 factor = _mm_and_ps(moving, _mm_div_ps(step, length));
+		_mm_storeu_ps(streams.positionX + i, _mm_add_ps(px, _mm_mul_ps(dx, factor)));
+		_mm_storeu_ps(streams.positionY + i, _mm_add_ps(py, _mm_mul_ps(dy, factor)));
+	}
+#endif
+
+	for (; i < streams.count; ++i) {
+		arriveOne(streams, i, deltaTime, invSlowingRadius, range);
+	}
+}
+
+/**
+ * @brief `seekBatch` repartido en bloques entre los hilos del `JobSystem`.
+ */
+void SteeringKernels::parallelSeek(const SteeringStreams& streams, float deltaTime, float range) {
+	JobSystem::instance().parallelFor(streams.count, ParallelGrain, [&](std::size_t begin, std::size_t end) {
+		seekBatch(streams.slice(begin, end), deltaTime, range);
+	});
+}
+
+/**
+ * @brief `arriveBatch` repartido en bloques entre los hilos del `JobSystem`.
+ */
+void SteeringKernels::parallelArrive(const SteeringStreams& streams, float deltaTime, float slowingRadius, float range) {
+	JobSystem::instance().parallelFor(streams.count, ParallelGrain, [&](std::size_t begin, std::size_t end) {
+		arriveBatch(streams.slice(begin, end), deltaTime, slowingRadius, range);
+	});
+}
+
+/**
+ * @brief Copia las posiciones de varias formas a arreglos SoA.
+ */
+void SteeringKernels::gatherPositions(ShapeFactory* const* shapes, std::size_t count, float* positionX, float* positionY) {
+	for (std::size_t i = 0; i < count; ++i) {
+		const sf::Vector2f& position = shapes[i]->getPosition();
+		positionX[i] = position.x;
+		positionY[i] = position.y;
+	}
+}
+
+/**
+ * @brief Escribe de vuelta en las formas las posiciones de arreglos SoA.
+ *
+ * Solo desde un hilo: `updateBounds` modifica el rbol de cajas compartido.
+ */
+void SteeringKernels::scatterPositions(ShapeFactory* const* shapes, std::size_t count, const float* positionX, const float* positionY) {
+	for (std::size_t i = 0; i < count; ++i) {
+		shapes[i]->getTransformable().setPosition(positionX[i], positionY[i]);
+	}
+	for (std::size_t i = 0; i < count; ++i) {
+		shapes[i]->updateBounds();
+	}
+}
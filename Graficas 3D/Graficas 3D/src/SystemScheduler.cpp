@@ -0,0 +1,85 @@
+#include "SystemScheduler.h"
+#include "World.h"
+#include <algorithm>
+
+/**
+ * @brief Ejecuta todos los sistemas para un fotograma.
+ * @param world World de la aplicacin.
+ * @param deltaTime Tiempo transcurrido desde el ltimo fotograma, en segundos.
+ *
+ * Lanza los sistemas sin dependencias y espera a que terminen todos; el resto se
+ * lanza a medida que se cumplen sus dependencias. El hilo que llama ejecuta sistemas
+ * mientras espera.
+ */
+void SystemScheduler::update(World& world, float deltaTime) {
+	buildGraph();
+
+	for (std::size_t i = 0; i < m_systems.size(); ++i) {
+		m_remaining[i].store(m_dependencyCount[i], std::memory_order_relaxed);
+	}
+
+	JobCounter counter;
+	for (std::size_t i = 0; i < m_systems.size(); ++i) {
+		if (m_dependencyCount[i] == 0) {
+			scheduleSystem(i, world, deltaTime, counter);
+		}
+	}
+	JobSystem::instance().wait(counter);
+}
+
+/**
+ * @brief Destruye todos los sistemas.
+ */
+void SystemScheduler::clear() {
+	m_dependents.clear();
+	m_dependencyCount.clear();
+	m_remaining.reset();
+	m_systems.clear();
+}
+
+/**
+ * @brief Construye el grafo de dependencias entre los sistemas.
+ *
+ * Un sistema depende de cada sistema anterior con el que entra en conflicto.
+ */
+void SystemScheduler::buildGraph() {
+	const std::size_t count = m_systems.size();
+	m_dependents.assign(count, std::vector<std::size_t>());
+	m_dependencyCount.assign(count, 0);
+	m_remaining.reset(new std::atomic<std::uint32_t>[count]);
+
+	std::vector<std::size_t> depth(count, 1);
+	m_criticalPath = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		for (std::size_t j = 0; j < i; ++j) {
+			if (m_systems[i]->conflictsWith(*m_systems[j])) {
+				m_dependents[j].push_back(i);
+				++m_dependencyCount[i];
+				depth[i] = std::max(depth[i], depth[j] + 1);
+			}
+		}
+		m_criticalPath = std::max(m_criticalPath, depth[i]);
+	}
+}
+
+/**
+ * @brief Programa un sistema como trabajo del JobSystem.
+ * @param index ndice del sistema.
+ * @param world World de la aplicacin.
+ * @param deltaTime Tiempo transcurrido desde el ltimo fotograma.
+ * @param counter Contador del fotograma.
+ *
+ * Al terminar, descuenta una dependencia a cada sistema que depende de l y programa
+ * los que ya no esperan a ninguno. El decremento con acquire/release garantiza que
+ * ven las escrituras del sistema anterior.
+ */
+void SystemScheduler::scheduleSystem(std::size_t index, World& world, float deltaTime, JobCounter& counter) {
+	JobSystem::instance().schedule([this, index, &world, deltaTime, &counter]() {
+		m_systems[index]->update(world, deltaTime);
+		for (std::size_t dependent : m_dependents[index]) {
+			if (m_remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				scheduleSystem(dependent, world, deltaTime, counter);
+			}
+		}
+	}, &counter);
+}
@@ -0,0 +1,190 @@
+#include "UniformGrid.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+	/// Puntos mnimos por bloque; con menos, repartir cuesta ms de lo que ahorra.
+	constexpr std::size_t MinChunkPoints = 2048;
+	/// Celdas mnimas permitidas antes de agrandar el lado de la celda.
+	constexpr std::size_t MinCellBudget = 4096;
+}
+
+/**
+ * @brief Constructor.
+ * @param cellSize Lado de las celdas.
+ */
+UniformGrid::UniformGrid(float cellSize) {
+	setCellSize(cellSize);
+}
+
+/**
+ * @brief Cambia el lado de las celdas; se aplica en el siguiente `build`.
+ */
+void UniformGrid::setCellSize(float cellSize) {
+	m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+}
+
+/**
+ * @brief Reconstruye la rejilla.
+ * @param positionX Posiciones X de los puntos.
+ * @param positionY Posiciones Y de los puntos.
+ * @param count Nmero de puntos.
+ *
+ * Tres pasadas en paralelo sobre los mismos bloques (caja, conteo por celda y
+ * escritura) y dos cortas en serie (unir cajas y la suma prefija).
+ */
+void UniformGrid::build(const float* positionX, const float* positionY, std::size_t count) {
+	m_indices.resize(count);
+	m_sortedX.resize(count);
+	m_sortedY.resize(count);
+	m_pointCell.resize(count);
+	if (count == 0) {
+		m_columns = 0;
+		m_rows = 0;
+		m_cellStart.assign(1, 0);
+		return;
+	}
+
+	JobSystem& jobs = JobSystem::instance();
+	// Un bloque por hilo como mucho: el conteo guarda una fila de celdas por bloque.
+	const std::size_t chunkTarget = std::min(jobs.workerCount() + 1, (count + MinChunkPoints - 1) / MinChunkPoints);
+	const std::size_t grain = (count + chunkTarget - 1) / chunkTarget;
+	const std::size_t chunkCount = (count + grain - 1) / grain;
+
+	// Caja de los puntos finitos; un NaN o un infinito la dejara sin tamao til.
+	m_chunkBounds.resize(chunkCount);
+	jobs.parallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+		const float infinity = std::numeric_limits<float>::infinity();
+		Bounds bounds{ infinity, infinity, -infinity, -infinity };
+		for (std::size_t i = begin; i < end; ++i) {
+			if (!std::isfinite(positionX[i]) || !std::isfinite(positionY[i])) continue;
+			bounds.minX = std::min(bounds.minX, positionX[i]);
+			bounds.minY = std::min(bounds.minY, positionY[i]);
+			bounds.maxX = std::max(bounds.maxX, positionX[i]);
+			bounds.maxY = std::max(bounds.maxY, positionY[i]);
+		}
+		m_chunkBounds[begin / grain] = bounds;
+	});
+	Bounds bounds = m_chunkBounds[0];
+	for (std::size_t chunk = 1; chunk < chunkCount; ++chunk) {
+		bounds.minX = std::min(bounds.minX, m_chunkBounds[chunk].minX);
+		bounds.minY = std::min(bounds.minY, m_chunkBounds[chunk].minY);
+		bounds.maxX = std::max(bounds.maxX, m_chunkBounds[chunk].maxX);
+		bounds.maxY = std::max(bounds.maxY, m_chunkBounds[chunk].maxY);
+	}
+	if (bounds.minX > bounds.maxX) {
+		bounds = Bounds{ 0.0f, 0.0f, 0.0f, 0.0f }; // Ningn punto finito.
+	}
+
+	// Dimensiones, agrandando la celda si hicieran falta demasiadas. El ancho se mide en
+	// double para que no se desborde; as la celda alcanza a cubrir la caja antes de
+	// llegar al mximo de float y el ciclo siempre termina.
+	const std::size_t cellBudget = std::max(MinCellBudget, count * 2);
+	const double spanX = static_cast<double>(bounds.maxX) - bounds.minX;
+	const double spanY = static_cast<double>(bounds.maxY) - bounds.minY;
+	float cellSize = m_cellSize;
+	while (true) {
+		const double columns = std::floor(spanX / cellSize) + 1.0;
+		const double rows = std::floor(spanY / cellSize) + 1.0;
+		if (columns * rows <= static_cast<double>(cellBudget)) {
+			m_columns = static_cast<int>(columns);
+			m_rows = static_cast<int>(rows);
+			break;
+		}
+		cellSize *= 2.0f;
+	}
+	m_invCellSize = 1.0f / cellSize;
+	m_originX = bounds.minX;
+	m_originY = bounds.minY;
+	const std::size_t cells = cellCount();
+
+	// Conteo por bloque y celda.
+	m_chunkCounts.assign(chunkCount * cells, 0);
+	jobs.parallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+		std::uint32_t* counts = m_chunkCounts.data() + (begin / grain) * cells;
+		for (std::size_t i = begin; i < end; ++i) {
+			std::uint32_t cell = 0; // Los puntos no finitos van a la primera celda.
+			if (std::isfinite(positionX[i]) && std::isfinite(positionY[i])) {
+				// La resta puede desbordarse a infinito en cajas enormes; cae en la ltima celda.
+				const float x = (positionX[i] - m_originX) * m_invCellSize;
+				const float y = (positionY[i] - m_originY) * m_invCellSize;
+				const int column = x < m_columns - 1 ? static_cast<int>(x) : m_columns - 1;
+				const int row = y < m_rows - 1 ? static_cast<int>(y) : m_rows - 1;
+				cell = static_cast<std::uint32_t>(row * m_columns + column);
+			}
+			m_pointCell[i] = cell;
+			++counts[cell];
+		}
+	});
+
+	// Suma prefija por celda y, dentro de cada celda, por bloque.
+	m_cellStart.resize(cells + 1);
+	std::uint32_t offset = 0;
+	for (std::size_t cell = 0; cell < cells; ++cell) {
+		m_cellStart[cell] = offset;
+		for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+			std::uint32_t& slot = m_chunkCounts[chunk * cells + cell];
+			const std::uint32_t chunkPoints = slot;
+			slot = offset;
+			offset += chunkPoints;
+		}
+	}
+	m_cellStart[cells] = offset;
+
+	// Cada bloque escribe sus puntos en los huecos que le tocan.
+	jobs.parallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+		std::uint32_t* slots = m_chunkCounts.data() + (begin / grain) * cells;
+		for (std::size_t i = begin; i < end; ++i) {
+			const std::uint32_t k = slots[m_pointCell[i]]++;
+			m_indices[k] = static_cast<std::uint32_t>(i);
+			m_sortedX[k] = positionX[i];
+			m_sortedY[k] = positionY[i];
+		}
+	});
+}
+
+/**
+ * @brief Busca los `k` puntos ms cercanos a un centro.
+ * @param center Centro de la bsqueda.
+ * @param k Nmero de puntos a buscar.
+ * @param out Vector donde se dejan, del ms cercano al ms lejano.
+ *
+ * Busca en un crculo que empieza del tamao de una celda y se duplica hasta que tiene
+ * al menos `k` puntos o cubre toda la rejilla. Cuando hay `k` puntos dentro, ninguno
+ * de afuera puede estar ms cerca que ellos, as que el resultado es exacto. Los
+ * empates se resuelven por ndice. Un centro NaN o infinito no tiene vecinos, y la
+ * bsqueda tambin termina si el radio llega a infinito.
+ */
+void UniformGrid::queryNearest(const sf::Vector2f& center, std::size_t k, std::vector<Neighbour>& out) const {
+	out.clear();
+	if (k == 0 || m_indices.empty() || !std::isfinite(center.x) || !std::isfinite(center.y)) {
+		return;
+	}
+
+	// Distancia del centro a la esquina ms lejana de la rejilla.
+	const float width = m_columns / m_invCellSize;
+	const float height = m_rows / m_invCellSize;
+	const float farX = std::max(std::abs(center.x - m_originX), std::abs(m_originX + width - center.x));
+	const float farY = std::max(std::abs(center.y - m_originY), std::abs(m_originY + height - center.y));
+	const float farthest = std::sqrt(farX * farX + farY * farY);
+
+	float radius = 1.0f / m_invCellSize;
+	while (true) {
+		out.clear();
+		queryRadius(center, radius, [&out](std::uint32_t index, float distanceSquared) {
+			out.push_back(Neighbour{ index, distanceSquared });
+		});
+		if (out.size() >= k || radius >= farthest || !std::isfinite(radius)) {
+			break;
+		}
+		radius *= 2.0f;
+	}
+
+	const std::size_t found = std::min(k, out.size());
+	std::partial_sort(out.begin(), out.begin() + found, out.end(), [](const Neighbour& a, const Neighbour& b) {
+		return a.distanceSquared < b.distanceSquared
+			|| (a.distanceSquared == b.distanceSquared && a.index < b.index);
+	});
+	out.resize(found);
+}
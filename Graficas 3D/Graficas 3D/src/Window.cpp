@@ -9,8 +9,17 @@
  * @param width Ancho de la ventana.
  * @param height Alto de la ventana.
  * @param title Ttulo de la ventana.
+ * @param backend Dnde dibuja la ventana. Con `SOFTWARE` no se abre ninguna
+ * ventana y se crea un framebuffer en memoria del mismo tamao.
  */
-Window::Window(int width, int height, const std::string& title) {
+Window::Window(int width, int height, const std::string& title, WindowBackend backend) : m_backend(backend) {
+	if (m_backend == SOFTWARE) {
+		m_rasterizer.create(width, height);
+		m_headlessOpen = true;
+		MESSAGE("Window", "Window", "OK (SOFTWARE)"); // Mensaje de confirmacin.
+		return;
+	}
+
 	m_window = new sf::RenderWindow(sf::VideoMode(width, height), title);
 
 	if (!m_window) {
@@ -36,6 +45,9 @@ Window::~Window() {
  * Este mtodo procesa todos los eventos de la ventana, como la solicitud de cierre.
  */
 void Window::handleEvents() {
+	if (isHeadless()) {
+		return; // Sin ventana real no hay eventos.
+	}
 	sf::Event event;
 	while (m_window->pollEvent(event)) {
 		if (event.type == sf::Event::Closed)
@@ -50,7 +62,13 @@ void Window::handleEvents() {
  * renderizado.
  */
 void Window::clear() {
+	if (isHeadless()) {
+		m_renderQueue.clear();
+		m_rasterizer.clear();
+		return;
+	}
 	if (m_window != nullptr) {
+		m_renderQueue.clear(); // Descarta lo que qued encolado.
 		m_window->clear(); // Limpia la ventana.
 	}
 	else {
@@ -62,10 +80,16 @@ void Window::clear() {
  * @brief Muestra el contenido actual de la ventana.
  *
  * Este mtodo actualiza la ventana para mostrar el contenido que ha sido dibujado
- * desde la ltima llamada a clear().
+ * desde la ltima llamada a clear(). Antes dibuja los lotes de la cola.
  */
 void Window::display() {
+	if (isHeadless()) {
+		m_renderQueue.flush(m_rasterizer); // Rasteriza las formas encoladas en la CPU.
+		m_rasterizer.resolve();
+		return;
+	}
 	if (m_window != nullptr) {
+		m_renderQueue.flush(*m_window); // Dibuja las formas encoladas.
 		m_window->display(); // Muestra el contenido de la ventana.
 	}
 	else {
@@ -81,6 +105,9 @@ void Window::display() {
  * @return true si la ventana est abierta, false en caso contrario.
  */
 bool Window::isOpen() const {
+	if (isHeadless()) {
+		return m_headlessOpen;
+	}
 	if (m_window != nullptr) {
 		return m_window->isOpen(); // Devuelve el estado de apertura de la ventana.
 	}
@@ -90,6 +117,20 @@ bool Window::isOpen() const {
 	}
 }
 
+/**
+ * @brief Cierra la ventana.
+ *
+ * Despus de esto `isOpen` devuelve false, lo que termina el bucle de la aplicacin.
+ */
+void Window::close() {
+	if (isHeadless()) {
+		m_headlessOpen = false;
+	}
+	else if (m_window != nullptr) {
+		m_window->close();
+	}
+}
+
 /**
  * @brief Dibuja un objeto en la ventana.
  *
@@ -97,9 +138,24 @@ bool Window::isOpen() const {
  * en la ventana.
  *
  * @param drawable Referencia al objeto a dibujar.
+ *
+ * Primero dibuja lo que haya en la cola, para respetar el orden de dibujo.
+ * Con el backend `SOFTWARE` solo se pueden dibujar formas (`sf::Shape`).
  */
 void Window::draw(const sf::Drawable& drawable) {
+	if (isHeadless()) {
+		const sf::Shape* shape = dynamic_cast<const sf::Shape*>(&drawable);
+		if (shape == nullptr) {
+			MESSAGE("Window", "draw", "SOFTWARE BACKEND ONLY DRAWS sf::Shape, SKIPPED");
+			return;
+		}
+		m_renderQueue.flush(m_rasterizer);
+		m_renderQueue.submit(*shape);
+		m_renderQueue.flush(m_rasterizer);
+		return;
+	}
 	if (m_window != nullptr) {
+		m_renderQueue.flush(*m_window);
 		m_window->draw(drawable); // Dibuja el objeto en la ventana.
 	}
 	else {
@@ -107,14 +163,92 @@ void Window::draw(const sf::Drawable& drawable) {
 	}
 }
 
+/**
+ * @brief Encola una forma para dibujarse en lote.
+ *
+ * La forma se dibuja en el siguiente display(), junto con las dems formas
+ * que compartan textura y modo de mezcla.
+ *
+ * @param shape Forma a dibujar.
+ * @param order Capa, profundidad y modo de mezcla.
+ */
+void Window::submit(const sf::Shape& shape, const DrawOrder& order) {
+	m_renderQueue.submit(shape, order);
+}
+
+/**
+ * @brief Encola una copia de una geometra compartida para dibujarse en lote.
+ *
+ * @param mesh Geometra en espacio local.
+ * @param transform Transformacin de la copia.
+ * @param color Color de relleno de la copia.
+ * @param order Capa, profundidad y modo de mezcla.
+ */
+void Window::submit(const ShapeMesh& mesh, const sf::Transform& transform, const sf::Color& color,
+                    const DrawOrder& order) {
+	m_renderQueue.submit(mesh, transform, color, order);
+}
+
+/**
+ * @brief Obtiene el rectngulo de mundo que cubre la vista actual.
+ *
+ * Transforma el rectngulo de coordenadas normalizadas (-1, -1)-(1, 1) con la
+ * transformacin inversa de la vista, as que tiene en cuenta centro, tamao y
+ * rotacin.
+ *
+ * @return La caja de la vista, o un rectngulo vaco si no hay ventana.
+ */
+sf::FloatRect Window::getViewBounds() const {
+	if (isHeadless()) {
+		return m_rasterizer.getViewBounds();
+	}
+	if (m_window != nullptr) {
+		return m_window->getView().getInverseTransform().transformRect(sf::FloatRect(-1.0f, -1.0f, 2.0f, 2.0f));
+	}
+	else {
+		ERROR("Window", "getViewBounds", "CHECK FOR WINDOW POINTER DATA"); // Manejo de errores.
+		return sf::FloatRect();
+	}
+}
+
+/**
+ * @brief Guarda como imagen lo que se mostr en el ltimo `display`.
+ *
+ * Con el backend `SOFTWARE` guarda el framebuffer; con la ventana de SFML copia
+ * su contenido a una textura y de ah a una imagen.
+ *
+ * @param path Ruta del archivo; el formato sale de la extensin (png, bmp, tga, jpg).
+ * @return true si se guard.
+ */
+bool Window::saveFrame(const std::string& path) {
+	if (isHeadless()) {
+		return m_rasterizer.saveToFile(path);
+	}
+	if (m_window == nullptr) {
+		ERROR("Window", "saveFrame", "CHECK FOR WINDOW POINTER DATA"); // Manejo de errores.
+		return false;
+	}
+
+	sf::Texture texture;
+	if (!texture.create(m_window->getSize().x, m_window->getSize().y)) {
+		return false;
+	}
+	texture.update(*m_window);
+	return texture.copyToImage().saveToFile(path);
+}
+
 /**
  * @brief Obtiene el puntero a la ventana de SFML.
  *
- * Este mtodo devuelve el puntero a la ventana de SFML.
+ * Este mtodo devuelve el puntero a la ventana de SFML. Con el backend
+ * `SOFTWARE` no hay ventana y devuelve nullptr.
  *
  * @return Un puntero a la ventana de SFML, o nullptr si hay un problema con el puntero.
  */
 sf::RenderWindow* Window::getWindow() {
+	if (isHeadless()) {
+		return nullptr;
+	}
 	if (m_window != nullptr) {
 		return m_window; // Devuelve el puntero a la ventana.
 	}
@@ -132,4 +266,5 @@ sf::RenderWindow* Window::getWindow() {
  */
 void Window::destroy() {
 	SAFE_PTR_RELEASE(m_window); // Llama a la macro para liberar el puntero.
+	m_headlessOpen = false;
 }
@@ -0,0 +1,78 @@
+#include "World.h"
+
+/**
+ * @brief Destruye una entidad y sus componentes.
+ * @param entity Handle de la entidad.
+ * @return true si la entidad exista.
+ *
+ * Si otra entidad pasa a ocupar la fila liberada, se actualiza su registro.
+ */
+bool World::destroyEntity(EntityHandle entity) {
+	EntityRecord* record = m_entities.get(entity);
+	if (record == nullptr) {
+		return false;
+	}
+
+	EntityHandle moved = record->archetype->destroyRow(record->row);
+	if (!moved.isNull()) {
+		m_entities.get(moved)->row = record->row;
+	}
+	m_entities.destroy(entity);
+	return true;
+}
+
+/**
+ * @brief Destruye todas las entidades y arquetipos.
+ */
+void World::clear() {
+	m_entities.clear();
+	m_archetypeIndex.clear();
+	m_archetypes.clear();
+}
+
+/**
+ * @brief Crea el arquetipo de un conjunto de columnas.
+ * @param columns Columnas en cualquier orden.
+ * @return El arquetipo creado.
+ *
+ * Las columnas se ordenan por identificador de tipo para que su ndice se pueda
+ * calcular a partir de la mscara.
+ */
+Archetype* World::createArchetype(std::vector<ComponentColumnInfo> columns) {
+	std::sort(columns.begin(), columns.end(),
+		[](const ComponentColumnInfo& a, const ComponentColumnInfo& b) { return a.typeID < b.typeID; });
+
+	m_archetypes.push_back(std::make_unique<Archetype>(std::move(columns)));
+	Archetype* archetype = m_archetypes.back().get();
+	m_archetypeIndex[archetype->mask()] = archetype;
+	return archetype;
+}
+
+/**
+ * @brief Mueve una entidad a otro arquetipo.
+ * @param entity Handle de la entidad.
+ * @param record Registro de la entidad.
+ * @param target Arquetipo de destino.
+ */
+void World::moveEntity(EntityHandle entity, EntityRecord& record, Archetype* target) {
+	Archetype* source = record.archetype;
+	Archetype::Row row = target->allocateRow(entity);
+
+	const std::vector<ComponentColumnInfo>& columns = source->columns();
+	for (std::uint32_t i = 0; i < columns.size(); ++i) {
+		void* component = source->componentAt(record.row, i);
+		if (target->mask() & (ComponentMask(1) << columns[i].typeID)) {
+			columns[i].moveAndDestroy(target->componentAt(row, target->columnIndex(columns[i].typeID)), component);
+		}
+		else {
+			columns[i].destroy(component);
+		}
+	}
+
+	EntityHandle moved = source->removeRow(record.row);
+	if (!moved.isNull()) {
+		m_entities.get(moved)->row = record.row;
+	}
+	record.archetype = target;
+	record.row = row;
+}